@@ -28,6 +28,15 @@ std::string                                        ADHydro::adhydroOutputGeometr
 std::string                                        ADHydro::adhydroOutputParameterFilePath;
 std::string                                        ADHydro::adhydroOutputStateFilePath;
 std::string                                        ADHydro::adhydroOutputDisplayFilePath;
+std::string                                        ADHydro::adhydroOutputHydrographFilePath;
+std::string                                        ADHydro::hydrographGaugeFilePath;
+int                                                ADHydro::hydrographBufferSize;
+std::string                                        ADHydro::adhydroOutputCatchmentFilePath;
+std::string                                        ADHydro::adhydroOutputRasterFilePath;
+std::string                                        ADHydro::adhydroOutputXDMFDirectoryPath;
+bool                                               ADHydro::outputXDMFFiles;
+bool                                               ADHydro::catchmentAggregation;
+double                                             ADHydro::rasterAggregationCellSize;
 double                                             ADHydro::centralMeridian;
 double                                             ADHydro::falseEasting;
 double                                             ADHydro::falseNorthing;
@@ -36,10 +45,12 @@ double                                             ADHydro::currentTime;
 double                                             ADHydro::simulationDuration;
 double                                             ADHydro::checkpointPeriod;
 double                                             ADHydro::outputPeriod;
+int                                                ADHydro::massBalanceInterval;
 InfiltrationAndGroundwater::InfiltrationMethodEnum ADHydro::infiltrationMethod;
 bool                                               ADHydro::drainDownMode;
 double                                             ADHydro::drainDownTime;
 bool                                               ADHydro::doMeshMassage;
+bool                                               ADHydro::separateChannelRegions;
 bool                                               ADHydro::zeroExpirationTime;
 bool                                               ADHydro::zeroCumulativeFlow;
 bool                                               ADHydro::zeroWaterError;
@@ -191,6 +202,15 @@ ADHydro::ADHydro(CkArgMsg* msg)
   adhydroOutputParameterFilePath         = superfile.Get("", "adhydroOutputParameterFilePath", adhydroOutputDirectoryPath + "/parameter.nc");
   adhydroOutputStateFilePath             = superfile.Get("", "adhydroOutputStateFilePath",     adhydroOutputDirectoryPath + "/state.nc");
   adhydroOutputDisplayFilePath           = superfile.Get("", "adhydroOutputDisplayFilePath",   adhydroOutputDirectoryPath + "/display.nc");
+  adhydroOutputHydrographFilePath        = superfile.Get("", "adhydroOutputHydrographFilePath", adhydroOutputDirectoryPath + "/hydrograph");
+  hydrographGaugeFilePath                = superfile.Get("", "hydrographGaugeFilePath", "");
+  hydrographBufferSize                   = superfile.GetInteger("", "hydrographBufferSize", 4096);
+  adhydroOutputCatchmentFilePath         = superfile.Get("", "adhydroOutputCatchmentFilePath", adhydroOutputDirectoryPath + "/catchment.txt");
+  adhydroOutputRasterFilePath            = superfile.Get("", "adhydroOutputRasterFilePath",    adhydroOutputDirectoryPath + "/raster.txt");
+  catchmentAggregation                   = superfile.GetBoolean("", "catchmentAggregation", false);
+  rasterAggregationCellSize              = superfile.GetReal("", "rasterAggregationCellSize", 0.0);
+  adhydroOutputXDMFDirectoryPath         = superfile.Get("", "adhydroOutputXDMFDirectoryPath", adhydroOutputDirectoryPath);
+  outputXDMFFiles                        = superfile.GetBoolean("", "outputXDMFFiles", true);
   
   centralMeridian = superfile.GetReal("", "centralMeridianRadians", NAN);
   
@@ -231,10 +251,11 @@ ADHydro::ADHydro(CkArgMsg* msg)
         }
     }
   
-  currentTime        = superfile.GetReal("", "currentTime", NAN);
-  simulationDuration = superfile.GetReal("", "simulationDuration", 0.0);
-  checkpointPeriod   = superfile.GetReal("", "checkpointPeriod", INFINITY);
-  outputPeriod       = superfile.GetReal("", "outputPeriod", INFINITY);
+  currentTime         = superfile.GetReal("", "currentTime", NAN);
+  simulationDuration  = superfile.GetReal("", "simulationDuration", 0.0);
+  checkpointPeriod    = superfile.GetReal("", "checkpointPeriod", INFINITY);
+  outputPeriod        = superfile.GetReal("", "outputPeriod", INFINITY);
+  massBalanceInterval = superfile.GetInteger("", "massBalanceInterval", 1);
   
 #if (DEBUG_LEVEL & DEBUG_LEVEL_USER_INPUT_SIMPLE)
   if (!(0.0 <= simulationDuration))
@@ -254,6 +275,24 @@ ADHydro::ADHydro(CkArgMsg* msg)
       CkError("ERROR in ADHydro::ADHydro: outputPeriod must be greater than zero.\n");
       CkExit();
     }
+  
+  if (!(0 < massBalanceInterval))
+    {
+      CkError("ERROR in ADHydro::ADHydro: massBalanceInterval must be greater than zero.\n");
+      CkExit();
+    }
+  
+  if (!(0 < hydrographBufferSize))
+    {
+      CkError("ERROR in ADHydro::ADHydro: hydrographBufferSize must be greater than zero.\n");
+      CkExit();
+    }
+  
+  if (!(0.0 <= rasterAggregationCellSize))
+    {
+      CkError("ERROR in ADHydro::ADHydro: rasterAggregationCellSize must be greater than or equal to zero.\n");
+      CkExit();
+    }
 #endif // (DEBUG_LEVEL & DEBUG_LEVEL_USER_INPUT_SIMPLE)
   
   infiltrationMethodString = superfile.Get("", "infiltrationMethod", "NO_INFILTRATION");
@@ -278,13 +317,14 @@ ADHydro::ADHydro(CkArgMsg* msg)
     }
 #endif // (DEBUG_LEVEL & DEBUG_LEVEL_USER_INPUT_SIMPLE)
   
-  drainDownMode      = superfile.GetBoolean("", "drainDownMode", false);
-  drainDownTime      = superfile.GetReal("", "drainDownTime", 0.0);
-  doMeshMassage      = superfile.GetBoolean("", "doMeshMassage", false);
-  zeroExpirationTime = superfile.GetBoolean("", "zeroExpirationTime", false);
-  zeroCumulativeFlow = superfile.GetBoolean("", "zeroCumulativeFlow", false);
-  zeroWaterError     = superfile.GetBoolean("", "zeroWaterError", false);
-  verbosityLevel     = superfile.GetInteger("", "verbosityLevel", 2);
+  drainDownMode          = superfile.GetBoolean("", "drainDownMode", false);
+  drainDownTime          = superfile.GetReal("", "drainDownTime", 0.0);
+  doMeshMassage          = superfile.GetBoolean("", "doMeshMassage", false);
+  separateChannelRegions = superfile.GetBoolean("", "separateChannelRegions", false);
+  zeroExpirationTime     = superfile.GetBoolean("", "zeroExpirationTime", false);
+  zeroCumulativeFlow     = superfile.GetBoolean("", "zeroCumulativeFlow", false);
+  zeroWaterError         = superfile.GetBoolean("", "zeroWaterError", false);
+  verbosityLevel         = superfile.GetInteger("", "verbosityLevel", 2);
   
   // Create file manager.
   fileManagerProxy = CProxy_FileManager::ckNew();
@@ -40,22 +40,33 @@ public:
   static std::string                                        adhydroOutputParameterFilePath;
   static std::string                                        adhydroOutputStateFilePath;
   static std::string                                        adhydroOutputDisplayFilePath;
-  static double                                             centralMeridian;    // Radians.
-  static double                                             falseEasting;       // Meters.
-  static double                                             falseNorthing;      // Meters.
-  static double                                             referenceDate;      // Julian date.
-  static double                                             currentTime;        // Seconds.
-  static double                                             simulationDuration; // Seconds.
-  static double                                             checkpointPeriod;   // Seconds.
-  static double                                             outputPeriod;       // Seconds.
+  static std::string                                        adhydroOutputHydrographFilePath;
+  static std::string                                        hydrographGaugeFilePath;
+  static int                                                hydrographBufferSize;      // Number of records.
+  static std::string                                        adhydroOutputCatchmentFilePath;
+  static std::string                                        adhydroOutputRasterFilePath;
+  static std::string                                        adhydroOutputXDMFDirectoryPath;
+  static bool                                               outputXDMFFiles;           // Flag.
+  static bool                                               catchmentAggregation;      // Flag.
+  static double                                             rasterAggregationCellSize; // Meters.
+  static double                                             centralMeridian;           // Radians.
+  static double                                             falseEasting;              // Meters.
+  static double                                             falseNorthing;             // Meters.
+  static double                                             referenceDate;             // Julian date.
+  static double                                             currentTime;               // Seconds.
+  static double                                             simulationDuration;        // Seconds.
+  static double                                             checkpointPeriod;          // Seconds.
+  static double                                             outputPeriod;              // Seconds.
+  static int                                                massBalanceInterval;       // Number of sync points.
   static InfiltrationAndGroundwater::InfiltrationMethodEnum infiltrationMethod;
-  static bool                                               drainDownMode;      // Flag.
-  static double                                             drainDownTime;      // Seconds.
-  static bool                                               doMeshMassage;      // Flag.
-  static bool                                               zeroExpirationTime; // Flag.
-  static bool                                               zeroCumulativeFlow; // Flag.
-  static bool                                               zeroWaterError;     // Flag.
-  static int                                                verbosityLevel;     // Unitless.
+  static bool                                               drainDownMode;             // Flag.
+  static double                                             drainDownTime;             // Seconds.
+  static bool                                               doMeshMassage;             // Flag.
+  static bool                                               separateChannelRegions;    // Flag.
+  static bool                                               zeroExpirationTime;        // Flag.
+  static bool                                               zeroCumulativeFlow;        // Flag.
+  static bool                                               zeroWaterError;            // Flag.
+  static int                                                verbosityLevel;            // Unitless.
   static CProxy_FileManager                                 fileManagerProxy;
   static CProxy_Region                                      regionProxy;
   
@@ -0,0 +1,98 @@
+#include "aggregate.h"
+#include <map>
+
+void AggregateRecord::add(const AggregateRecord& other)
+{
+  area                     += other.area;
+  surfacewaterVolume       += other.surfacewaterVolume;
+  groundwaterHeadTimesArea += other.groundwaterHeadTimesArea;
+  precipitationVolume      += other.precipitationVolume;
+  evaporationVolume        += other.evaporationVolume;
+  transpirationVolume      += other.transpirationVolume;
+}
+
+bool writeAggregates(CkReductionMsg* msg, const std::string& outputFilePath, double rasterCellSize)
+{
+  bool                                                     error         = false;                                    // Error flag.
+  CkReduction::setElement*                                 setElement    = (CkReduction::setElement*)msg->getData(); // Loop iterator.
+  AggregateRecord*                                         records;                                                  // Records in one contribution.
+  int                                                      numberOfRecords;                                          // Number of records in one contribution.
+  int                                                      ii;                                                       // Loop counter.
+  double                                                   time          = 0.0;                                      // Simulation time of the records.
+  std::map<std::pair<int, int>, AggregateRecord>           zones;                                                    // Combined records.  Key is (zoneX, zoneY).
+  std::map<std::pair<int, int>, AggregateRecord>::iterator it;                                                       // Loop iterator.
+  FILE*                                                    aggregateFile = NULL;                                     // The file to append to.
+
+#if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
+  if (!(0.0 <= rasterCellSize))
+    {
+      CkError("ERROR in writeAggregates: rasterCellSize must be greater than or equal to zero.\n");
+      error = true;
+    }
+#endif // (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
+
+  for (; !error && NULL != setElement; setElement = setElement->next())
+    {
+      records         = (AggregateRecord*)&setElement->data;
+      numberOfRecords = setElement->dataSize / sizeof(AggregateRecord);
+
+#if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
+      CkAssert(0 == setElement->dataSize % sizeof(AggregateRecord));
+#endif // (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
+
+      for (ii = 0; ii < numberOfRecords; ++ii)
+        {
+          time = records[ii].time;
+
+          if (0.0 < records[ii].area)
+            {
+              it = zones.find(std::pair<int, int>(records[ii].zoneX, records[ii].zoneY));
+
+              if (zones.end() == it)
+                {
+                  zones[std::pair<int, int>(records[ii].zoneX, records[ii].zoneY)] = records[ii];
+                }
+              else
+                {
+                  (*it).second.add(records[ii]);
+                }
+            }
+        }
+    }
+
+  if (!error && !zones.empty())
+    {
+      aggregateFile = fopen(outputFilePath.c_str(), "a");
+
+#if (DEBUG_LEVEL & DEBUG_LEVEL_LIBRARY_ERRORS)
+      if (!(NULL != aggregateFile))
+        {
+          CkError("ERROR in writeAggregates: could not open aggregate file %s.\n", outputFilePath.c_str());
+          error = true;
+        }
+#endif // (DEBUG_LEVEL & DEBUG_LEVEL_LIBRARY_ERRORS)
+
+      for (it = zones.begin(); !error && it != zones.end(); ++it)
+        {
+          if (0.0 == rasterCellSize)
+            {
+              fprintf(aggregateFile, "%lf,\t%d,\t", time, (*it).second.zoneX);
+            }
+          else
+            {
+              fprintf(aggregateFile, "%lf,\t%lf,\t%lf,\t", time, ((*it).second.zoneX + 0.5) * rasterCellSize, ((*it).second.zoneY + 0.5) * rasterCellSize);
+            }
+
+          fprintf(aggregateFile, "%lf,\t%lf,\t%lf,\t%lf,\t%lf,\t%lf\n", (*it).second.area, (*it).second.surfacewaterVolume / (*it).second.area,
+                  (*it).second.groundwaterHeadTimesArea / (*it).second.area, (*it).second.precipitationVolume / (*it).second.area,
+                  (*it).second.evaporationVolume / (*it).second.area, (*it).second.transpirationVolume / (*it).second.area);
+        }
+
+      if (NULL != aggregateFile)
+        {
+          fclose(aggregateFile);
+        }
+    }
+
+  return error;
+}
@@ -0,0 +1,61 @@
+#ifndef __AGGREGATE_H__
+#define __AGGREGATE_H__
+
+#include "all_charm.h"
+
+// An AggregateRecord is the sum over some mesh elements of state variables
+// weighted by element area.  Each record belongs to one zone.  A zone is either
+// a catchment, in which case zoneX is the catchment ID number and zoneY is
+// zero, or a raster cell, in which case zoneX and zoneY are the column and row
+// of the cell.  Column zero, row zero is the cell whose lower left corner is at
+// the origin of the map projection.
+//
+// Regions sum their own mesh elements into one record per zone and contribute
+// the records to a CkReduction::set reduction.  The file manager on PE 0 then
+// sums records from different regions that belong to the same zone and
+// divides by area to get area weighted means.  This way the output is a few
+// numbers per zone instead of the full state of every element.
+//
+// A region with no mesh elements contributes a single record with zero area
+// because a CkReduction::set reduction cannot contain empty contributions.
+// Records with zero area are not written to file.
+class AggregateRecord
+{
+public:
+
+  // Add the values of other to this record.
+  //
+  // Parameters:
+  //
+  // other - The record to add to this record.
+  void add(const AggregateRecord& other);
+
+  double time;                     // Simulation time of the record in seconds since ADHydro::referenceDate.
+  int    zoneX;                    // Catchment ID number, or raster column.
+  int    zoneY;                    // Zero, or raster row.
+  double area;                     // Total area of mesh elements in square meters.
+  double surfacewaterVolume;       // Sum of surfacewaterDepth times elementArea in cubic meters.
+  double groundwaterHeadTimesArea; // Sum of groundwaterHead times elementArea in meters times square meters.
+  double precipitationVolume;      // Sum of cumulative precipitation times elementArea in cubic meters.  Negative means water added.
+  double evaporationVolume;        // Sum of cumulative evaporation times elementArea in cubic meters.  Negative means water added.
+  double transpirationVolume;      // Sum of cumulative transpiration times elementArea in cubic meters.  Negative means water added.
+};
+
+// Combine the records in a CkReduction::set reduction by zone and append one
+// line per zone to a text file.  Each line has the columns time, zone, area,
+// mean surfacewater depth, mean groundwater head, cumulative precipitation,
+// cumulative evaporation, and cumulative transpiration.  Zone is the catchment
+// ID number if rasterCellSize is zero, or the X and Y coordinates of the cell
+// center otherwise.  Depths and cumulative values are in meters of water.
+//
+// Returns: true if there is an error, false otherwise.
+//
+// Parameters:
+//
+// msg            - The reduction message containing AggregateRecords.  This
+//                  function does not delete msg.
+// outputFilePath - Path of the text file to append to.
+// rasterCellSize - Raster cell size in meters, or zero for catchments.
+bool writeAggregates(CkReductionMsg* msg, const std::string& outputFilePath, double rasterCellSize);
+
+#endif // __AGGREGATE_H__
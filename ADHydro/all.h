@@ -78,6 +78,16 @@
 // Set this macro to the debug level to use.
 #define DEBUG_LEVEL (DEBUG_LEVEL_DEVELOPMENT)
 
+// Set this macro to nonzero to calculate the fractional powers in Manning's
+// equation with powTwoThirds and powFiveThirds below using cbrt instead of
+// pow.  cbrt is several times faster than pow and its results differ from pow
+// by no more than a few units in the last place.  The default is zero, which
+// uses pow and reproduces previous results exactly.  It can be overridden with
+// -DFAST_FRACTIONAL_POWERS=1 in EXTRAFLAGS in the makefile.
+#ifndef FAST_FRACTIONAL_POWERS
+#define FAST_FRACTIONAL_POWERS (0)
+#endif // FAST_FRACTIONAL_POWERS
+
 // Constants.
 #define GRAVITY               (9.81)      // Meters per second squared.
 #define POLAR_RADIUS_OF_EARTH (6356752.3) // Meters.
@@ -220,6 +230,33 @@ inline bool epsilonEqual(float a, float b, float epsilonProxy = 0.0)
   return !epsilonLess(a, b, epsilonProxy) && !epsilonGreater(a, b, epsilonProxy);
 }
 
+// Utility functions for the fixed fractional powers used in Manning's
+// equation.  x must be non-negative.
+
+// Returns: x raised to the two thirds power.
+inline double powTwoThirds(double x)
+{
+#if (FAST_FRACTIONAL_POWERS)
+  double cubeRoot = cbrt(x); // x raised to the one third power.
+  
+  return cubeRoot * cubeRoot;
+#else // (FAST_FRACTIONAL_POWERS)
+  return pow(x, 2.0 / 3.0);
+#endif // (FAST_FRACTIONAL_POWERS)
+}
+
+// Returns: x raised to the five thirds power.
+inline double powFiveThirds(double x)
+{
+#if (FAST_FRACTIONAL_POWERS)
+  double cubeRoot = cbrt(x); // x raised to the one third power.
+  
+  return x * cubeRoot * cubeRoot;
+#else // (FAST_FRACTIONAL_POWERS)
+  return pow(x, 5.0 / 3.0);
+#endif // (FAST_FRACTIONAL_POWERS)
+}
+
 // Utility functions for converting dates.
 
 // Convert Gregorian date to Julian date.
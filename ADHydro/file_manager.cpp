@@ -1,6 +1,8 @@
 #include "file_manager.h"
 #include "adhydro.h"
 #include "garto.h"
+#include "aggregate.h"
+#include "mass_balance.h"
 #include <sys/stat.h>
 #include <libgen.h>
 
@@ -104,13 +106,18 @@ time_t FileManager::wallclockTimeAtStart = time(NULL); // We want to record the
 double FileManager::massBalanceShouldBe  = NAN;        // The first mass balance value to use as the "should be" value for the rest of the simulation.
                                                        // Starts out as NAN until a mass balance completes.
 
-void FileManager::printOutMassBalance(double messageTime, double waterInDomain, double externalFlows, double waterError)
+void FileManager::printOutMassBalance(CkReductionMsg* msg)
 {
-  time_t wallclockTime = time(NULL);
-  double massBalance   = waterInDomain + externalFlows - waterError;
+  time_t             wallclockTime = time(NULL);
+  MassBalanceRecord* record        = (MassBalanceRecord*)msg->getData();
+  double             massBalance   = record->waterInDomain + record->externalFlows - record->waterError;
+  
+#if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
+  CkAssert(sizeof(MassBalanceRecord) == msg->getSize());
+#endif // (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
   
 #if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
-  if (!(0.0 <= waterInDomain))
+  if (!(0.0 <= record->waterInDomain))
     {
       CkError("ERROR in FileManager::printOutMassBalance: waterInDomain must be greater than or equal to zero.\n");
       CkExit();
@@ -123,17 +130,36 @@ void FileManager::printOutMassBalance(double messageTime, double waterInDomain,
     }
   
   CkPrintf("simulation time = %.0lf [s], elapsed wallclock time = %d [s], waterInDomain = %lg [m^3], externalFlows = %lg [m^3], waterError = %lg [m^3], "
-           "massBalance = %lg [m^3], massBalanceError = %lg [m^3].\n", messageTime, wallclockTime - wallclockTimeAtStart, waterInDomain, externalFlows,
-           waterError, massBalance, massBalance - massBalanceShouldBe);
+           "massBalance = %lg [m^3], massBalanceError = %lg [m^3].\n", record->time, wallclockTime - wallclockTimeAtStart, record->waterInDomain,
+           record->externalFlows, record->waterError, massBalance, massBalance - massBalanceShouldBe);
   
-  // FIXME mass balance reduction still locks up so this can't be blocking
-  //ADHydro::regionProxy.barrier();
-  //
   // Signal file manager zero when the last mass balance finishes so that it knows it can end the program.
-  //if (messageTime == ADHydro::fileManagerProxy.ckLocalBranch()->simulationEndTime)
-  //  {
-  //    ADHydro::fileManagerProxy[0].massBalanceDone();
-  //  }
+  if (simulationEndTime == record->time)
+    {
+      thisProxy[0].massBalanceDone();
+    }
+  
+  delete msg;
+}
+
+void FileManager::writeCatchmentAggregates(CkReductionMsg* msg)
+{
+  if (writeAggregates(msg, ADHydro::adhydroOutputCatchmentFilePath, 0.0))
+    {
+      CkExit();
+    }
+  
+  delete msg;
+}
+
+void FileManager::writeRasterAggregates(CkReductionMsg* msg)
+{
+  if (writeAggregates(msg, ADHydro::adhydroOutputRasterFilePath, ADHydro::rasterAggregationCellSize))
+    {
+      CkExit();
+    }
+  
+  delete msg;
 }
 
 int FileManager::home(int item, int globalNumberOfItems)
@@ -389,6 +415,13 @@ FileManager::FileManager() :
   sdagCondition(false),
   reservoirFactory(),
   diversionFactory(),
+  hydrographWriter(),
+  stateXDMFWriter(),
+  displayXDMFWriter(),
+  xdmfGeometryInstancesSize(0),
+  xdmfParameterInstancesSize(0),
+  xdmfStateInstancesSize(0),
+  xdmfDisplayInstancesSize(0),
   NetCDFMPIComm(),
   geometryFileID(),
   geometryFileOpen(false),
@@ -3993,6 +4026,12 @@ void FileManager::NetCDFCreateInstances()
         }
     }
   
+  // The state file now has all of the instances it will have for this run.
+  if (!error)
+    {
+      xdmfStateInstancesSize = std::max(xdmfStateInstancesSize, existingInstances + instanceIndex);
+    }
+  
   delete[] existingReferenceDates;
   delete[] existingCurrentTimes;
   existingReferenceDates = NULL;
@@ -4324,6 +4363,12 @@ void FileManager::NetCDFCreateInstances()
         }
     }
   
+  // The display file now has all of the instances it will have for this run.
+  if (!error)
+    {
+      xdmfDisplayInstancesSize = std::max(xdmfDisplayInstancesSize, existingInstances + instanceIndex);
+    }
+  
   delete[] existingReferenceDates;
   delete[] existingCurrentTimes;
   delete[] newCurrentTimes;
@@ -7105,6 +7150,30 @@ void FileManager::writeNetCDFFiles()
       error = NetCDFWriteDisplay(displayFileID, displayFileOpen);
     }
   
+  // Record the instances just written for the XDMF files.  The number of instances in a file never decreases so keep the largest number of instances
+  // known for each file.  The files were closed by the write methods so use the sizes read above plus any instance just written at the end.
+  if (!error && 0 == CkMyPe() && ADHydro::outputXDMFFiles)
+    {
+      xdmfGeometryInstancesSize  = std::max(xdmfGeometryInstancesSize,  std::max(geometryInstancesSize,  geometryInstance  + 1));
+      xdmfParameterInstancesSize = std::max(xdmfParameterInstancesSize, std::max(parameterInstancesSize, parameterInstance + 1));
+      
+      if (writeState)
+        {
+          xdmfStateInstancesSize = std::max(xdmfStateInstancesSize, std::max(stateInstancesSize, stateInstance + 1));
+          
+          stateXDMFWriter.addInstance(currentTime, geometryInstance, parameterInstance, stateInstance, globalNumberOfMeshNodes, globalNumberOfMeshElements,
+                                      globalNumberOfChannelNodes, globalNumberOfChannelElements);
+        }
+      
+      if (writeDisplay)
+        {
+          xdmfDisplayInstancesSize = std::max(xdmfDisplayInstancesSize, std::max(displayInstancesSize, displayInstance + 1));
+          
+          displayXDMFWriter.addInstance(currentTime, geometryInstance, parameterInstance, displayInstance, globalNumberOfMeshNodes, globalNumberOfMeshElements,
+                                        globalNumberOfChannelNodes, globalNumberOfChannelElements);
+        }
+    }
+  
   // Close the geometry file.
   if ((simulationEndTime == currentTime || ADHydro::currentTime == currentTime) && geometryFileOpen)
     {
@@ -7175,6 +7244,27 @@ void FileManager::writeNetCDFFiles()
     }
 }
 
+void FileManager::writeXDMFFiles()
+{
+  bool error = false; // Error flag.
+  
+#if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
+  CkAssert(0 == CkMyPe() && ADHydro::outputXDMFFiles);
+#endif // (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
+  
+  error = stateXDMFWriter.write(xdmfGeometryInstancesSize, xdmfParameterInstancesSize, xdmfStateInstancesSize);
+  
+  if (!error)
+    {
+      error = displayXDMFWriter.write(xdmfGeometryInstancesSize, xdmfParameterInstancesSize, xdmfDisplayInstancesSize);
+    }
+  
+  if (error)
+    {
+      CkExit();
+    }
+}
+
 void FileManager::updateVertices()
 {
   int                                                             ii, jj;                             // Loop counters.
@@ -8160,6 +8250,7 @@ void FileManager::meshMassage()
   int                      ii, jj, kk;                // Loop counters.
   bool                     regionsReassigned = false; // Whether regions were reassigned.
   std::map<long long, int> regionMap;                 // Mapping from catchment and reach code numbers to region indexes.
+  std::map<long long, int> channelRegionMap;          // Mapping from reach code numbers to region indexes if ADHydro::separateChannelRegions is true.
   bool                     hasLowerNeighbor;          // Whether an element has a lower neighbor.
   bool                     hasChannelNeighbor;        // Whether an element has a channel neighbor.
   int                      downstreamElement;         // An element or boundary condition code downstream of an element.
@@ -8291,10 +8382,14 @@ void FileManager::meshMassage()
     }
 #endif // (DEBUG_LEVEL & DEBUG_LEVEL_USER_INPUT_SIMPLE)
   
-  // Assign elements to regions if they haven't been already.
-  if (NULL == meshRegion || NULL == channelRegion)
+  // Assign elements to regions if they haven't been already or if channel elements must be moved to their own regions.
+  if (NULL == meshRegion || NULL == channelRegion || ADHydro::separateChannelRegions)
     {
-      // Start by creating a mapping from catchment and reach code numbers to region indexes.
+      // Start by creating a mapping from catchment and reach code numbers to region indexes.  If ADHydro::separateChannelRegions is true reach codes
+      // get their own map so that a reach code that happens to have the same number as a catchment does not put channel and mesh elements in the same
+      // region.
+      std::map<long long, int>& reachCodeMap = ADHydro::separateChannelRegions ? channelRegionMap : regionMap; // Mapping used for reach code numbers.
+      
       regionsReassigned     = true;
       globalNumberOfRegions = 0;
       
@@ -8309,9 +8404,9 @@ void FileManager::meshMassage()
       
       for (ii = 0; ii < globalNumberOfChannelElements; ii++)
         {
-          if (regionMap.end() == regionMap.find(channelReachCode[ii]))
+          if (reachCodeMap.end() == reachCodeMap.find(channelReachCode[ii]))
             {
-              regionMap[channelReachCode[ii]] = globalNumberOfRegions;
+              reachCodeMap[channelReachCode[ii]] = globalNumberOfRegions;
               globalNumberOfRegions++;
             }
         }
@@ -8341,7 +8436,7 @@ void FileManager::meshMassage()
       
       for (ii = 0; ii < globalNumberOfChannelElements; ii++)
         {
-          channelRegion[ii] = regionMap[channelReachCode[ii]];
+          channelRegion[ii] = reachCodeMap[channelReachCode[ii]];
         }
     }
   
@@ -9591,9 +9686,11 @@ void FileManager::calculateDerivedValues()
                                            bcPsib);
 
                     // FIXLATER What value for initial water content?  Currently set to 10% of porosity
-                    garto_domain_alloc(&gartoDomain, gartoParameters, 0.0, meshElementSoilDepth[ii],
+                    // Elements with identical parameter values share one copy of the parameters.
+                    garto_domain_alloc(&gartoDomain, garto_parameters_shared(gartoParameters), 0.0, meshElementSoilDepth[ii],
                                        InfiltrationAndGroundwater::SHALLOW_AQUIFER == meshGroundwaterMethod[ii], meshPorosity[ii] * 0.1, true,
                                        meshElementZSurface[ii] - meshGroundwaterHead[ii]);
+                    garto_parameters_dealloc(&gartoParameters);
 
                     // Assignment operator handles deallocating any previous state.
                     meshVadoseZone[ii] = InfiltrationAndGroundwater::VadoseZone(InfiltrationAndGroundwater::GARTO_INFILTRATION, gartoDomain);
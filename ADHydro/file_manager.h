@@ -3,6 +3,8 @@
 
 #include "adhydro_netcdf.h"
 #include "region.h"
+#include "hydrograph_writer.h"
+#include "xdmf_writer.h"
 #include "ReservoirFactory.h"
 #include "DiversionFactory.h"
 
@@ -119,30 +121,30 @@ public:
   static double massBalanceShouldBe;
   
   // Print out the mass balance check.  This is a reduction target that
-  // collects all mass balance values from all regions.  To calculate the
-  // mass balance take waterInDomain and add externalFlows and subtract
-  // waterError.  This will undo any insertion or removal of water from the
-  // "black box" of the simulation domain leaving the amount of water that was
-  // present when externalFlows and waterError were both zero.  This value
-  // should be invariant except for floating point roundoff error.
+  // collects all mass balance values from all regions.  Only called on the
+  // file manager on PE 0.  To calculate the mass balance take waterInDomain
+  // and add externalFlows and subtract waterError.  This will undo any
+  // insertion or removal of water from the "black box" of the simulation
+  // domain leaving the amount of water that was present when externalFlows and
+  // waterError were both zero.  This value should be invariant except for
+  // floating point roundoff error.  When the mass balance for the end of the
+  // simulation arrives tell this file manager it can exit.
   //
   // Parameters:
   //
-  // messageTime   - The simulation time in seconds since
-  //                 ADHydro::referenceDate when the mass balance was
-  //                 collected.
-  // waterInDomain - The amount of water in cubic meters in the entire domain.
-  //                 Positive means the existance of water.  Must be
-  //                 non-negative.
-  // externalFlows - The amount of water in cubic meters that has flowed to or
-  //                 from external sources and sinks (boundary conditions,
-  //                 precipitation, E-T, etc.) for the entire domain.  Positive
-  //                 means flow out of the domain.  Negative means flow into
-  //                 the domain.
-  // waterError    - The amount of water in cubic meters that was created or
-  //                 destroyed be error in the entire domain.  Positive means
-  //                 water was created.  Negative means water was destroyed.
-  static void printOutMassBalance(double messageTime, double waterInDomain, double externalFlows, double waterError);
+  // msg - Reduction message containing one MassBalanceRecord summed over the
+  //       entire domain.  Deleted here.
+  void printOutMassBalance(CkReductionMsg* msg);
+
+  // Reduction targets for catchment and raster aggregates contributed by
+  // Region::contributeAggregates.  Only called on the file manager on PE 0.
+  // Appends the aggregates to the catchment or raster output file.
+  //
+  // Parameters:
+  //
+  // msg - Reduction message containing AggregateRecords.  Deleted here.
+  void writeCatchmentAggregates(CkReductionMsg* msg);
+  void writeRasterAggregates(CkReductionMsg* msg);
 
   // Calculate which file manager owns a given item.  Items are generally mesh
   // elements, although this function can be used to distribute any set of
@@ -344,6 +346,12 @@ public:
   // Write out file manager data to NetCDF files.
   void writeNetCDFFiles();
   
+  // Rewrite the XDMF files to include the instances written to the state and
+  // display files so far.  This should be called only by the file manager for
+  // PE zero after writeNetCDFFiles, and at the beginning of the simulation
+  // after NetCDFCreateInstances.
+  void writeXDMFFiles();
+  
   // Check if vertex variables need to be updated from node variables and if so
   // send out get vertex data messages.
   void updateVertices();
@@ -775,6 +783,17 @@ public:
   ReservoirFactory reservoirFactory; // A singleton factory for creating Reservoir objects.
   DiversionFactory diversionFactory; // A singleton factory for creating Diversion objects.
   
+  // Buffered hydrograph output for channel elements in regions on this PE.
+  HydrographWriter hydrographWriter;
+  
+  // XDMF metadata for the state and display files.  Only used on PE zero.
+  XDMFWriter stateXDMFWriter;            // XDMF files describing the state file.
+  XDMFWriter displayXDMFWriter;          // XDMF files describing the display file.
+  size_t     xdmfGeometryInstancesSize;  // Number of instances in the geometry file.
+  size_t     xdmfParameterInstancesSize; // Number of instances in the parameter file.
+  size_t     xdmfStateInstancesSize;     // Number of instances in the state file.
+  size_t     xdmfDisplayInstancesSize;   // Number of instances in the display file.
+  
   // NetCDF I/O variables
   MPI_Comm NetCDFMPIComm;     // A duplicate of MPI_COMM_WORLD used instead because of collisions with Charm++ also using MPI.
   int      geometryFileID;    // ID of geometry file.
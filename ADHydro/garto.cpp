@@ -1,4 +1,5 @@
 #include "garto.h"
+#include <map>
 
 int garto_parameters_alloc(garto_parameters** parameters, int num_bins, double conductivity, double porosity, double residual_saturation, int van_genutchen,
                            double vg_alpha, double vg_n, double bc_lambda, double bc_psib)
@@ -111,6 +112,14 @@ int garto_parameters_alloc(garto_parameters** parameters, int num_bins, double c
       (*parameters)->bc_psib                 = bc_psib;
       (*parameters)->saturated_conductivity  = conductivity;
       
+      // Derived Brooks-Corey values.  These are calculated with the same expressions that used to be evaluated in the Brooks-Corey functions so
+      // results are unchanged.
+      (*parameters)->theta_range               = porosity - residual_saturation;
+      (*parameters)->bc_conductivity_exponent  = 3.0 + 2.0 / bc_lambda;
+      (*parameters)->bc_pressure_head_exponent = -1.0 / bc_lambda;
+      (*parameters)->bc_capillary_exponent     = 3.0 + 1.0 / bc_lambda;
+      (*parameters)->bc_capillary_denominator  = 3.0 * bc_lambda + 1.0;
+      
       if (van_genutchen)
         {
           (*parameters)->effective_capillary_suction = (1.0 / vg_alpha) * (0.046 * m + 2.07 * m * m + 19.5 * m * m * m) / (1 + 4.7 * m + 16.0 * m * m);
@@ -144,6 +153,77 @@ void garto_parameters_dealloc(garto_parameters** parameters)
     }
 }
 
+// Ordering of garto_parameters structs by value for the table of shared structs.
+struct garto_parameters_less
+{
+  bool operator()(const garto_parameters& parameters_1, const garto_parameters& parameters_2) const
+  {
+    if (parameters_1.num_bins != parameters_2.num_bins)
+      {
+        return parameters_1.num_bins < parameters_2.num_bins;
+      }
+    else if (parameters_1.theta_r != parameters_2.theta_r)
+      {
+        return parameters_1.theta_r < parameters_2.theta_r;
+      }
+    else if (parameters_1.theta_s != parameters_2.theta_s)
+      {
+        return parameters_1.theta_s < parameters_2.theta_s;
+      }
+    else if (parameters_1.vg_alpha != parameters_2.vg_alpha)
+      {
+        return parameters_1.vg_alpha < parameters_2.vg_alpha;
+      }
+    else if (parameters_1.vg_n != parameters_2.vg_n)
+      {
+        return parameters_1.vg_n < parameters_2.vg_n;
+      }
+    else if (parameters_1.bc_lambda != parameters_2.bc_lambda)
+      {
+        return parameters_1.bc_lambda < parameters_2.bc_lambda;
+      }
+    else if (parameters_1.bc_psib != parameters_2.bc_psib)
+      {
+        return parameters_1.bc_psib < parameters_2.bc_psib;
+      }
+    else if (parameters_1.saturated_conductivity != parameters_2.saturated_conductivity)
+      {
+        return parameters_1.saturated_conductivity < parameters_2.saturated_conductivity;
+      }
+    else
+      {
+        return parameters_1.effective_capillary_suction < parameters_2.effective_capillary_suction;
+      }
+  }
+};
+
+// The table of shared structs.  std::map never moves its elements so pointers to them stay valid.  The table is shared by all PEs in the process so in SMP
+// builds it is only accessed while holding shared_parameters_lock.
+static std::map<garto_parameters, bool, garto_parameters_less> shared_parameters;
+static CmiNodeLock                                             shared_parameters_lock;
+
+void garto_parameters_shared_init()
+{
+  shared_parameters_lock = CmiCreateLock();
+}
+
+garto_parameters* garto_parameters_shared(const garto_parameters* parameters)
+{
+  garto_parameters* shared = NULL; // The shared struct to return.
+  
+  if (NULL != parameters)
+    {
+      CmiLock(shared_parameters_lock);
+      
+      // The key is the struct itself.  The mapped value is unused.
+      shared = const_cast<garto_parameters*>(&shared_parameters.insert(std::make_pair(*parameters, true)).first->first);
+      
+      CmiUnlock(shared_parameters_lock);
+    }
+  
+  return shared;
+}
+
 int garto_domain_alloc(garto_domain** domain, garto_parameters* parameters, double layer_top_depth, double layer_bottom_depth, int yes_groundwater,
                        double initial_water_content, int initialize_to_hydrostatic, double water_table)
 {
@@ -242,16 +322,17 @@ int garto_domain_alloc(garto_domain** domain, garto_parameters* parameters, doub
           (*domain)->initial_water_content = parameters->theta_r;
         }
 
-      // Allocate and initialize d_theta.
-      (*domain)->d_theta = new double[parameters->num_bins + 1];
+      // Allocate the bin arrays.
+      garto_domain_alloc_bins(*domain);
+
+      // Initialize d_theta.
 
       for (ii = 1; ii <= parameters->num_bins; ii++)
         {
           (*domain)->d_theta[ii] = 0.0;
         }
 
-      // Allocate and initialize surface_front_theta.
-      (*domain)->surface_front_theta = new double[parameters->num_bins + 1];
+      // Initialize surface_front_theta.
 
       // (*domain)->surface_front_theta[0] will be used in the simulation.
       for (ii = 0; ii <= parameters->num_bins; ii++)
@@ -259,8 +340,7 @@ int garto_domain_alloc(garto_domain** domain, garto_parameters* parameters, doub
           (*domain)->surface_front_theta[ii] = (*domain)->initial_water_content;
         }
 
-      // Allocate and initialize surface_front_depth.
-      (*domain)->surface_front_depth = new double[parameters->num_bins + 1];
+      // Initialize surface_front_depth.
 
       // (*domain)->surface_front_depth[0] will be used in the simulation.
       (*domain)->surface_front_depth[0] = layer_bottom_depth;
@@ -270,9 +350,8 @@ int garto_domain_alloc(garto_domain** domain, garto_parameters* parameters, doub
           (*domain)->surface_front_depth[ii] = layer_top_depth;
         }
 
-      // Allocate and initialize groundwater_front_theta.
-      (*domain)->groundwater_front_theta = new double[parameters->num_bins + 1];
-      delta_water_content                = (parameters->theta_s - (*domain)->initial_water_content) / parameters->num_bins;
+      // Initialize groundwater_front_theta.
+      delta_water_content = (parameters->theta_s - (*domain)->initial_water_content) / parameters->num_bins;
 
       // (*domain)->groundwater_front_theta[0] will be used in the simulation.
       for (ii = 0; ii < parameters->num_bins; ii++)
@@ -283,9 +362,7 @@ int garto_domain_alloc(garto_domain** domain, garto_parameters* parameters, doub
       // The last groundwater front bin should be exactly theta_s.
       (*domain)->groundwater_front_theta[parameters->num_bins] = parameters->theta_s;
 
-      // Allocate and initialize groundwater_front_depth.
-      (*domain)->groundwater_front_depth = new double[parameters->num_bins + 1];
-      
+      // Initialize groundwater_front_depth.
       if (yes_groundwater && initialize_to_hydrostatic)
         {
           // Initialize groundwater_front_depth to hydrostatic.
@@ -332,11 +409,8 @@ void garto_domain_dealloc(garto_domain** domain)
 
   if (NULL != domain && NULL != *domain)
     {
+      // The bin arrays are one block starting at d_theta.
       delete[] (*domain)->d_theta;
-      delete[] (*domain)->surface_front_theta;
-      delete[] (*domain)->surface_front_depth;
-      delete[] (*domain)->groundwater_front_theta;
-      delete[] (*domain)->groundwater_front_depth;
       delete *domain;
 
       *domain = NULL;
@@ -549,8 +623,8 @@ double conductivity_brooks_corey(garto_domain* domain, double water_content)
          epsilonEqual(water_content, domain->parameters->theta_s)  || epsilonEqual(water_content, domain->parameters->theta_r));
 #endif
  
-  double relative_water_content = (water_content - domain->parameters->theta_r) / (domain->parameters->theta_s - domain->parameters->theta_r);
-  double conductivity           = domain->parameters->saturated_conductivity * pow(relative_water_content, 3.0 + 2.0 / domain->parameters->bc_lambda);
+  double relative_water_content = (water_content - domain->parameters->theta_r) / domain->parameters->theta_range;
+  double conductivity           = domain->parameters->saturated_conductivity * pow(relative_water_content, domain->parameters->bc_conductivity_exponent);
   
   return conductivity;
 }
@@ -568,8 +642,8 @@ double pressure_head_brooks_corey(garto_domain* domain, double water_content)
           epsilonEqual(water_content, domain->parameters->theta_s) || epsilonEqual(water_content, domain->parameters->theta_r));
 #endif
 
-  double relative_water_content = (water_content - domain->parameters->theta_r) / (domain->parameters->theta_s - domain->parameters->theta_r);
-  double pressure_head          = domain->parameters->bc_psib * pow(relative_water_content, -1.0 /  domain->parameters->bc_lambda);
+  double relative_water_content = (water_content - domain->parameters->theta_r) / domain->parameters->theta_range;
+  double pressure_head          = domain->parameters->bc_psib * pow(relative_water_content, domain->parameters->bc_pressure_head_exponent);
   
   return pressure_head;
 }
@@ -587,18 +661,19 @@ double capillary_drive_brooks_corey(garto_domain* domain, double water_content_1
 #endif
   
   double capillary_drive;
-  double relative_water_content_1 = (water_content_1 - domain->parameters->theta_r) / (domain->parameters->theta_s - domain->parameters->theta_r);
-  double relative_water_content_2 = (water_content_2 - domain->parameters->theta_r) / (domain->parameters->theta_s - domain->parameters->theta_r);
+  double relative_water_content_1 = (water_content_1 - domain->parameters->theta_r) / domain->parameters->theta_range;
+  double relative_water_content_2;
   
   if (epsilonLess(water_content_2, domain->parameters->theta_s))
     {
-      capillary_drive = domain->parameters->bc_psib * (pow(relative_water_content_2, 3.0 + 1.0 / domain->parameters->bc_lambda) - 
-                        pow(relative_water_content_1, 3.0 + 1.0 / domain->parameters->bc_lambda)) / (3.0 * domain->parameters->bc_lambda + 1.0);
+      relative_water_content_2 = (water_content_2 - domain->parameters->theta_r) / domain->parameters->theta_range;
+      capillary_drive          = domain->parameters->bc_psib * (pow(relative_water_content_2, domain->parameters->bc_capillary_exponent) - 
+                                 pow(relative_water_content_1, domain->parameters->bc_capillary_exponent)) / domain->parameters->bc_capillary_denominator;
     }
   else
-    {
-      capillary_drive = domain->parameters->bc_psib *(3.0 * domain->parameters->bc_lambda + 2.0 - 
-                        pow(relative_water_content_1, 3.0 + 1.0 / domain->parameters->bc_lambda)) / (3.0 * domain->parameters->bc_lambda + 1.0);
+    { // relative_water_content_2 is one so its power is not needed.
+      capillary_drive          = domain->parameters->bc_psib *(3.0 * domain->parameters->bc_lambda + 2.0 - 
+                                 pow(relative_water_content_1, domain->parameters->bc_capillary_exponent)) / domain->parameters->bc_capillary_denominator;
     }
   
   return capillary_drive;
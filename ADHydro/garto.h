@@ -11,7 +11,10 @@
 // domain.  In the GARTO model, the Brooks-Corey soil model is used because the
 // capillary head across the wetting front between any water content
 // G(theta_1, theta_2) is available.  If van Genutchen soil parameters are
-// given, vg_alpha and vg_n are transformed to bc_lambda and bc_psib.
+// given, vg_alpha and vg_n are transformed to bc_lambda and bc_psib.  The
+// exponents and denominators of the Brooks-Corey functions depend only on the
+// soil so they are calculated once in garto_parameters_alloc instead of on
+// every call.
 typedef struct
 {
   int    num_bins;                    // The maximum number of bins that can be used.
@@ -23,13 +26,22 @@ typedef struct
   double bc_psib;                     // Brooks-Corey parameter in meters [m].  Value must be positive.
   double saturated_conductivity;      // Saturated hydraulic conducivity in meters per second [m/s].
   double effective_capillary_suction; // Effective capillary suction head used in Green-Ampt model in meters [m].
+  double theta_range;                 // theta_s - theta_r, unitless.
+  double bc_conductivity_exponent;    // Brooks-Corey conductivity exponent 3 + 2 / bc_lambda, unitless.
+  double bc_pressure_head_exponent;   // Brooks-Corey pressure head exponent -1 / bc_lambda, unitless.
+  double bc_capillary_exponent;       // Brooks-Corey capillary drive exponent 3 + 1 / bc_lambda, unitless.
+  double bc_capillary_denominator;    // Brooks-Corey capillary drive denominator 3 * bc_lambda + 1, unitless.
 } garto_parameters;
 
 PUPbytes(garto_parameters);
 
 // A garto_domain struct stores all of the state of a single GARTO domain.
 // Note: groundwater_front_theta, and groundwater_front_depth are allocated
-// even if yes_groundwater is false.
+// even if yes_groundwater is false.  The five bin arrays are allocated as one
+// block of memory by garto_domain_alloc_bins.  d_theta points to the start of
+// the block and the other arrays follow it in the order they are declared.
+// parameters is usually shared with other domains that have the same soil
+// parameters.  See garto_parameters_shared.
 typedef struct
 {
   garto_parameters* parameters;              // Constant soil paramters.
@@ -46,22 +58,60 @@ typedef struct
                                              // and water beyond initial_water_content falls out the bottom of the domain as if there were dry soil below it.
 } garto_domain;
 
+// Create the lock that protects the table of shared garto_parameters structs.
+// Called on every node at startup as an initnode function.
+void garto_parameters_shared_init();
+
+// Return a pointer to a garto_parameters struct with the same values as
+// parameters that is shared by all GARTO domains in this process that use
+// those values.  Shared structs are never freed so domains that use them must
+// not call garto_parameters_dealloc on them.  The values include conductivity
+// and porosity so only elements with identical values for all of the
+// parameters share a struct.  Safe to call from any PE in SMP builds.
+//
+// Returns: a pointer to the shared struct, or NULL if parameters is NULL.
+//
+// Parameters:
+//
+// parameters - A pointer to the values to look up.  Not modified.  The caller
+//              keeps ownership of this struct.
+garto_parameters* garto_parameters_shared(const garto_parameters* parameters);
+
+// Allocate the five bin arrays of a garto_domain as one block of memory.  The
+// values in the arrays are not initialized.  The block is freed by
+// garto_domain_dealloc.
+//
+// Parameters:
+//
+// domain - A pointer to the garto_domain struct.  domain->parameters must
+//          already be set.
+inline void garto_domain_alloc_bins(garto_domain* domain)
+{
+  int size = domain->parameters->num_bins + 1; // Size of each bin array.
+  
+  domain->d_theta                 = new double[5 * size];
+  domain->surface_front_theta     = domain->d_theta             + size;
+  domain->surface_front_depth     = domain->surface_front_theta + size;
+  domain->groundwater_front_theta = domain->surface_front_depth + size;
+  domain->groundwater_front_depth = domain->groundwater_front_theta + size;
+}
+
 inline void operator|(PUP::er &p, garto_domain &gd)
 {
-  if (p.isUnpacking())
+  garto_parameters parameters; // For unpacking parameters before finding the shared copy.
+  
+  if (!p.isUnpacking())
     {
-      gd.parameters = new garto_parameters;
+      parameters = *gd.parameters;
     }
   
-  p | *gd.parameters;
+  p | parameters;
   
   if (p.isUnpacking())
     {
-      gd.d_theta                 = new double[gd.parameters->num_bins + 1];
-      gd.surface_front_theta     = new double[gd.parameters->num_bins + 1];
-      gd.surface_front_depth     = new double[gd.parameters->num_bins + 1];
-      gd.groundwater_front_theta = new double[gd.parameters->num_bins + 1];
-      gd.groundwater_front_depth = new double[gd.parameters->num_bins + 1];
+      gd.parameters = garto_parameters_shared(&parameters);
+      
+      garto_domain_alloc_bins(&gd);
     }
   
   p | gd.top_depth;
@@ -144,7 +194,8 @@ int garto_domain_alloc(garto_domain** domain, garto_parameters* parameters, doub
 
 // Free memory allocated by garto_domain_alloc.  Does not free memory allocated
 // by garto_parameters_alloc because the garto_parameters struct might be
-// shared.  You need to call garto_parameters_dealloc separately.
+// shared.  You need to call garto_parameters_dealloc separately if the domain
+// does not use a struct from garto_parameters_shared.
 //
 // Parameters:
 //
@@ -0,0 +1,145 @@
+#include "hydrograph_writer.h"
+
+HydrographWriter::HydrographWriter() :
+  gauges(),
+  outputFilePath(),
+  bufferSize(0),
+  numberOfRecords(0),
+  buffer(NULL)
+{
+  // Initialization will be done in initialize.
+}
+
+HydrographWriter::~HydrographWriter()
+{
+  delete[] buffer;
+}
+
+bool HydrographWriter::initialize(const std::string& gaugeFilePath, const std::string& outputFilePathInit, int bufferSizeInit)
+{
+  bool  error     = false; // Error flag.
+  FILE* gaugeFile = NULL;  // The gauge file to read from.
+  int   element;           // Used to read gauge element numbers.
+  int   neighbor;          // Used to read gauge neighbor element numbers.
+
+#if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
+  if (!(0 < bufferSizeInit))
+    {
+      CkError("ERROR in HydrographWriter::initialize: bufferSizeInit must be greater than zero.\n");
+      error = true;
+    }
+#endif // (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
+
+  if (!error && !gaugeFilePath.empty())
+    {
+      gaugeFile = fopen(gaugeFilePath.c_str(), "r");
+
+#if (DEBUG_LEVEL & DEBUG_LEVEL_LIBRARY_ERRORS)
+      if (!(NULL != gaugeFile))
+        {
+          CkError("ERROR in HydrographWriter::initialize: could not open gauge file %s.\n", gaugeFilePath.c_str());
+          error = true;
+        }
+#endif // (DEBUG_LEVEL & DEBUG_LEVEL_LIBRARY_ERRORS)
+
+      while (!error && 2 == fscanf(gaugeFile, "%d %d", &element, &neighbor))
+        {
+#if (DEBUG_LEVEL & DEBUG_LEVEL_USER_INPUT_SIMPLE)
+          if (!(0 <= element && (0 <= neighbor || OUTFLOW == neighbor)))
+            {
+              CkError("ERROR in HydrographWriter::initialize: invalid gauge %d %d in gauge file.\n", element, neighbor);
+              error = true;
+            }
+#endif // (DEBUG_LEVEL & DEBUG_LEVEL_USER_INPUT_SIMPLE)
+
+          gauges.insert(std::pair<int, int>(element, neighbor));
+        }
+
+#if (DEBUG_LEVEL & DEBUG_LEVEL_USER_INPUT_SIMPLE)
+      if (!error && !feof(gaugeFile))
+        {
+          CkError("ERROR in HydrographWriter::initialize: unable to read gauge file %s.  It must contain only pairs of integers.\n", gaugeFilePath.c_str());
+          error = true;
+        }
+#endif // (DEBUG_LEVEL & DEBUG_LEVEL_USER_INPUT_SIMPLE)
+
+      if (NULL != gaugeFile)
+        {
+          fclose(gaugeFile);
+        }
+    }
+
+  if (!error)
+    {
+      outputFilePath  = outputFilePathInit;
+      bufferSize      = bufferSizeInit;
+      numberOfRecords = 0;
+
+      delete[] buffer;
+
+      buffer = new HydrographRecord[bufferSize];
+    }
+
+  return error;
+}
+
+bool HydrographWriter::record(int element, int neighbor, double time, double flowRate, double outwardFlowRateFraction)
+{
+  bool error = false; // Error flag.
+
+#if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
+  CkAssert(NULL != buffer && 0 <= numberOfRecords && numberOfRecords <= bufferSize);
+#endif // (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
+
+  if (numberOfRecords == bufferSize)
+    {
+      error = flush();
+    }
+
+  if (!error)
+    {
+      buffer[numberOfRecords].element                 = element;
+      buffer[numberOfRecords].neighbor                = neighbor;
+      buffer[numberOfRecords].time                    = time;
+      buffer[numberOfRecords].flowRate                = flowRate;
+      buffer[numberOfRecords].outwardFlowRateFraction = outwardFlowRateFraction;
+      ++numberOfRecords;
+    }
+
+  return error;
+}
+
+bool HydrographWriter::flush()
+{
+  bool  error          = false; // Error flag.
+  int   ii;                     // Loop counter.
+  FILE* hydrographFile = NULL;  // The hydrograph file to append to.
+
+  if (0 < numberOfRecords)
+    {
+      hydrographFile = fopen(outputFilePath.c_str(), "a");
+
+#if (DEBUG_LEVEL & DEBUG_LEVEL_LIBRARY_ERRORS)
+      if (!(NULL != hydrographFile))
+        {
+          CkError("ERROR in HydrographWriter::flush: could not open hydrograph file %s.\n", outputFilePath.c_str());
+          error = true;
+        }
+#endif // (DEBUG_LEVEL & DEBUG_LEVEL_LIBRARY_ERRORS)
+
+      for (ii = 0; !error && ii < numberOfRecords; ++ii)
+        {
+          fprintf(hydrographFile, "%d,\t%d,\t%lf,\t%lf,\t%lf\n", buffer[ii].element, buffer[ii].neighbor, buffer[ii].time, buffer[ii].flowRate,
+                  buffer[ii].outwardFlowRateFraction);
+        }
+
+      if (NULL != hydrographFile)
+        {
+          fclose(hydrographFile);
+        }
+
+      numberOfRecords = 0;
+    }
+
+  return error;
+}
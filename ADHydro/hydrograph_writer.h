@@ -0,0 +1,99 @@
+#ifndef __HYDROGRAPH_WRITER_H__
+#define __HYDROGRAPH_WRITER_H__
+
+#include "all_charm.h"
+#include <set>
+
+// A HydrographRecord is one sample of the flow through a gauge.
+class HydrographRecord
+{
+public:
+
+  int    element;                 // Channel element ID number of the element upstream of the gauge.
+  int    neighbor;                // Channel element ID number of the neighbor downstream of the gauge, or OUTFLOW for an outflow boundary.
+  double time;                    // Simulation time of the sample in seconds since ADHydro::referenceDate.
+  double flowRate;                // Nominal flow rate from element to neighbor in cubic meters per second.
+  double outwardFlowRateFraction; // Fraction of the nominal flow rate that element was actually able to satisfy, unitless.
+};
+
+// A HydrographWriter collects hydrographs of flow through a configurable set
+// of gauge locations and writes them to file.  There is one HydrographWriter
+// in each file manager so there is one hydrograph file per PE.  A gauge is
+// identified by a pair of channel element ID numbers, the element where the
+// water comes from and its downstream neighbor.  Flow to a channel outflow
+// boundary is always gauged.
+//
+// Channel elements produce one record per gauge per timestep.  Opening and
+// closing the file for each record is too slow when timesteps are short so
+// records are kept in a fixed size buffer and written to file in bulk when the
+// buffer fills up or when flush is called.  The file is a text file with one
+// record per line in the columns element, neighbor, time, flow rate, and
+// outward flow rate fraction.
+class HydrographWriter
+{
+public:
+
+  // Constructor.  The writer is initialized to have no gauges other than
+  // outflow boundaries and no buffer.  initialize must be called before
+  // record.
+  HydrographWriter();
+
+  // Destructor.  Dynamically allocated arrays need to be deleted.
+  ~HydrographWriter();
+
+  // Read the gauge list and allocate the record buffer.
+  //
+  // The gauge file is a text file of whitespace separated pairs of integers.
+  // Each pair is the element number of a channel element and the element
+  // number of its downstream channel neighbor.  An empty gauge file path means
+  // only outflow boundaries are gauged.
+  //
+  // Returns: true if there is an error, false otherwise.
+  //
+  // Parameters:
+  //
+  // gaugeFilePath      - Path of the gauge file to read, or empty.
+  // outputFilePathInit - Path of the hydrograph file to append records to.
+  // bufferSizeInit     - Number of records to hold in memory before writing
+  //                      to file.  Must be greater than zero.
+  bool initialize(const std::string& gaugeFilePath, const std::string& outputFilePathInit, int bufferSizeInit);
+
+  // Returns: true if flow from element to neighbor should be recorded, false
+  //          otherwise.
+  //
+  // Parameters:
+  //
+  // element  - Channel element ID number of the element the water comes from.
+  // neighbor - Channel element ID number of the neighbor the water goes to or
+  //            a boundary condition code.
+  inline bool isGauge(int element, int neighbor)
+  {
+    return (OUTFLOW == neighbor || (!gauges.empty() && gauges.end() != gauges.find(std::pair<int, int>(element, neighbor))));
+  }
+
+  // Add a record to the buffer.  If the buffer is full it is flushed first.
+  //
+  // Returns: true if there is an error, false otherwise.
+  //
+  // Parameters:
+  //
+  // Parameters directly initialize HydrographRecord member variables.  For
+  // description see HydrographRecord member variables.
+  bool record(int element, int neighbor, double time, double flowRate, double outwardFlowRateFraction);
+
+  // Append all buffered records to the hydrograph file and empty the buffer.
+  // Does nothing if the buffer is empty.
+  //
+  // Returns: true if there is an error, false otherwise.
+  bool flush();
+
+private:
+
+  std::set<std::pair<int, int> > gauges;          // Gauges other than outflow boundaries.  Key is (element, neighbor).
+  std::string                    outputFilePath;  // Path of the hydrograph file.
+  int                            bufferSize;      // The size of the allocated array pointed to by buffer.
+  int                            numberOfRecords; // The number of valid entries in buffer.
+  HydrographRecord*              buffer;          // Records that have not yet been written to file.
+};
+
+#endif // __HYDROGRAPH_WRITER_H__
@@ -0,0 +1,46 @@
+#include "mass_balance.h"
+
+CkReduction::reducerType massBalanceReducerType;
+
+void MassBalanceRecord::add(const MassBalanceRecord& other)
+{
+  waterInDomain += other.waterInDomain;
+  externalFlows += other.externalFlows;
+  waterError    += other.waterError;
+}
+
+CkReductionMsg* massBalanceReducer(int numberOfMessages, CkReductionMsg** messages)
+{
+  MassBalanceRecord  total = *(MassBalanceRecord*)messages[0]->getData(); // Combined record.
+  MassBalanceRecord* record;                                               // Record in one message.
+  int                ii;                                                   // Loop counter.
+
+#if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
+  CkAssert(0 < numberOfMessages && sizeof(MassBalanceRecord) == messages[0]->getSize());
+#endif // (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
+
+  for (ii = 1; ii < numberOfMessages; ++ii)
+    {
+      record = (MassBalanceRecord*)messages[ii]->getData();
+
+#if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
+      CkAssert(sizeof(MassBalanceRecord) == messages[ii]->getSize());
+
+      // If regions ever disagree about the sequence of sync points records from different times would end up in the same reduction.
+      if (!(total.time == record->time))
+        {
+          CkError("ERROR in massBalanceReducer: mass balance records from different simulation times in the same reduction.\n");
+          CkExit();
+        }
+#endif // (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
+
+      total.add(*record);
+    }
+
+  return CkReductionMsg::buildNew(sizeof(MassBalanceRecord), &total);
+}
+
+void registerMassBalanceReducer()
+{
+  massBalanceReducerType = CkReduction::addReducer(massBalanceReducer);
+}
@@ -0,0 +1,53 @@
+#ifndef __MASS_BALANCE_H__
+#define __MASS_BALANCE_H__
+
+#include "all_charm.h"
+
+// A MassBalanceRecord is the sum over some elements of the water terms of the
+// mass balance check along with the simulation time that they were collected.
+//
+// Regions sum their own elements into one record and contribute it to a
+// reduction that uses massBalanceReducerType.  The reducer sums the water
+// terms and carries the time through unchanged so the reduction target knows
+// which sync point the result belongs to without any region having to abuse
+// a sum to pass it along.  Charm++ keeps successive reductions over the region
+// array separate so a region can contribute the record for its next sync point
+// before the reduction for the previous one has finished.
+class MassBalanceRecord
+{
+public:
+
+  // Add the water terms of other to this record.
+  //
+  // Parameters:
+  //
+  // other - The record to add to this record.
+  void add(const MassBalanceRecord& other);
+
+  double time;          // Simulation time of the record in seconds since ADHydro::referenceDate.
+  double waterInDomain; // Cubic meters.  See Region::massBalance.
+  double externalFlows; // Cubic meters.  See Region::massBalance.
+  double waterError;    // Cubic meters.  See Region::massBalance.
+};
+
+// Reducer type for combining MassBalanceRecords.  Set by
+// registerMassBalanceReducer.
+extern CkReduction::reducerType massBalanceReducerType;
+
+// Combine the MassBalanceRecords in messages into a single record.  All
+// records must have the same time.
+//
+// Returns: a new reduction message containing one MassBalanceRecord.
+//
+// Parameters:
+//
+// numberOfMessages - The number of messages to combine.
+// messages         - Array of reduction messages each containing one
+//                    MassBalanceRecord.  This function does not delete them.
+CkReductionMsg* massBalanceReducer(int numberOfMessages, CkReductionMsg** messages);
+
+// Register massBalanceReducer with Charm++ and set massBalanceReducerType.
+// Called on every node at startup as an initnode function.
+void registerMassBalanceReducer();
+
+#endif // __MASS_BALANCE_H__
@@ -930,10 +930,9 @@ InfiltrationAndGroundwater::VadoseZone::VadoseZone(const VadoseZone &other) :
 
 InfiltrationAndGroundwater::VadoseZone::~VadoseZone()
 {
-  // Clean up dynamically allocated data.
+  // Clean up dynamically allocated data.  The parameters are shared so they are not deallocated.
   if (GARTO_INFILTRATION == infiltrationMethod)
     {
-      garto_parameters_dealloc(&(((garto_domain*)state)->parameters));
       garto_domain_dealloc((garto_domain**)&state);
     }
 }
@@ -942,10 +941,9 @@ InfiltrationAndGroundwater::VadoseZone& InfiltrationAndGroundwater::VadoseZone::
 {
   int ii; // Loop counter.
   
-  // Clean up dynamically allocated data.
+  // Clean up dynamically allocated data.  The parameters are shared so they are not deallocated.
   if (GARTO_INFILTRATION == infiltrationMethod)
     {
-      garto_parameters_dealloc(&((garto_domain*)state)->parameters);
       garto_domain_dealloc((garto_domain**)&state);
     }
   
@@ -956,35 +954,19 @@ InfiltrationAndGroundwater::VadoseZone& InfiltrationAndGroundwater::VadoseZone::
     {
       state = new garto_domain;
       
-      ((garto_domain*)state)->parameters = new garto_parameters;
-      
-      ((garto_domain*)state)->parameters->num_bins                    = ((garto_domain*)other.state)->parameters->num_bins;
-      ((garto_domain*)state)->parameters->theta_r                     = ((garto_domain*)other.state)->parameters->theta_r;
-      ((garto_domain*)state)->parameters->theta_s                     = ((garto_domain*)other.state)->parameters->theta_s;
-      ((garto_domain*)state)->parameters->vg_alpha                    = ((garto_domain*)other.state)->parameters->vg_alpha;
-      ((garto_domain*)state)->parameters->vg_n                        = ((garto_domain*)other.state)->parameters->vg_n;
-      ((garto_domain*)state)->parameters->bc_lambda                   = ((garto_domain*)other.state)->parameters->bc_lambda;
-      ((garto_domain*)state)->parameters->bc_psib                     = ((garto_domain*)other.state)->parameters->bc_psib;
-      ((garto_domain*)state)->parameters->saturated_conductivity      = ((garto_domain*)other.state)->parameters->saturated_conductivity;
-      ((garto_domain*)state)->parameters->effective_capillary_suction = ((garto_domain*)other.state)->parameters->effective_capillary_suction;
-      
+      // The parameters are shared so the copy uses the same struct.
+      ((garto_domain*)state)->parameters              = ((garto_domain*)other.state)->parameters;
       ((garto_domain*)state)->top_depth               = ((garto_domain*)other.state)->top_depth;
       ((garto_domain*)state)->bottom_depth            = ((garto_domain*)other.state)->bottom_depth;
-      ((garto_domain*)state)->d_theta                 = new double[((garto_domain*)state)->parameters->num_bins + 1];
-      ((garto_domain*)state)->surface_front_theta     = new double[((garto_domain*)state)->parameters->num_bins + 1];
-      ((garto_domain*)state)->surface_front_depth     = new double[((garto_domain*)state)->parameters->num_bins + 1];
-      ((garto_domain*)state)->groundwater_front_theta = new double[((garto_domain*)state)->parameters->num_bins + 1];
-      ((garto_domain*)state)->groundwater_front_depth = new double[((garto_domain*)state)->parameters->num_bins + 1];
       ((garto_domain*)state)->initial_water_content   = ((garto_domain*)other.state)->initial_water_content;
       ((garto_domain*)state)->yes_groundwater         = ((garto_domain*)other.state)->yes_groundwater;
       
-      for (ii = 0; ii <= ((garto_domain*)state)->parameters->num_bins; ii++)
+      garto_domain_alloc_bins((garto_domain*)state);
+      
+      // The bin arrays are one block starting at d_theta so they can be copied in one loop.
+      for (ii = 0; ii < 5 * (((garto_domain*)state)->parameters->num_bins + 1); ii++)
         {
-          ((garto_domain*)state)->d_theta[ii]                 = ((garto_domain*)other.state)->d_theta[ii];
-          ((garto_domain*)state)->surface_front_theta[ii]     = ((garto_domain*)other.state)->surface_front_theta[ii];
-          ((garto_domain*)state)->surface_front_depth[ii]     = ((garto_domain*)other.state)->surface_front_depth[ii];
-          ((garto_domain*)state)->groundwater_front_theta[ii] = ((garto_domain*)other.state)->groundwater_front_theta[ii];
-          ((garto_domain*)state)->groundwater_front_depth[ii] = ((garto_domain*)other.state)->groundwater_front_depth[ii];
+          ((garto_domain*)state)->d_theta[ii] = ((garto_domain*)other.state)->d_theta[ii];
         }
     }
 #if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
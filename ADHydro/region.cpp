@@ -2,6 +2,8 @@
 #include "adhydro.h"
 #include "file_manager.h"
 #include "garto.h"
+#include "aggregate.h"
+#include "mass_balance.h"
 
 RegionMessage::RegionMessage() :
   messageType(MESH_SURFACEWATER_MESH_NEIGHBOR), // Dummy values will be overwritten by pup_stl.h code.
@@ -299,6 +301,7 @@ Region::Region(double referenceDateInit, double currentTimeInit, double simulati
 #endif // (DEBUG_LEVEL & DEBUG_LEVEL_USER_INPUT_INVARIANTS) || (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_INVARIANTS)
   nextCheckpointIndex(1 + (int)floor(currentTimeInit / ADHydro::checkpointPeriod)),
   nextOutputIndex(1 + (int)floor(currentTimeInit / ADHydro::outputPeriod)),
+  syncCount(0),
   simulationFinished(false),
   nextForcingDataTime(NAN),
   sentMyDiversionsInitialized(false),
@@ -352,6 +355,7 @@ Region::Region(CkMigrateMessage* msg) :
   needToCheckInvariant(false),
   nextCheckpointIndex(0),
   nextOutputIndex(0),
+  syncCount(0),
   simulationFinished(false),
   nextForcingDataTime(NAN),
   sentMyDiversionsInitialized(false),
@@ -626,6 +630,7 @@ void Region::pup(PUP::er &p)
   p | needToCheckInvariant;
   p | nextCheckpointIndex;
   p | nextOutputIndex;
+  p | syncCount;
   p | simulationFinished;
   p | nextForcingDataTime;
   p | sentMyDiversionsInitialized;
@@ -3785,6 +3790,123 @@ void Region::sendStateToFileManagers()
           ADHydro::fileManagerProxy[(*it).first].sendElementStateMessages(currentTime, std::vector<ElementStateMessage>(), (*it).second);
         }
     }
+  
+  // Write out buffered hydrographs at each output time.  Other regions on this PE may have already emptied the buffer, in which case this does nothing.
+  if (fileManagerLocalBranch->hydrographWriter.flush())
+    {
+      CkExit();
+    }
+}
+
+void Region::contributeAggregates()
+{
+  std::map<std::pair<int, int>, AggregateRecord>           catchments; // Sums by catchment.  Key is (catchment, 0).
+  std::map<std::pair<int, int>, AggregateRecord>           cells;      // Sums by raster cell.  Key is (column, row).
+  std::map<std::pair<int, int>, AggregateRecord>::iterator it;         // Loop iterator.
+  std::vector<AggregateRecord>                             records;    // Records to contribute.
+  AggregateRecord                                          record;     // For filling in records.
+  
+#if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
+  // Iterators must not be in use at this time.
+  CkAssert(!pupItMeshAndItChannel && !pupItNeighbor);
+#endif // (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
+  
+  if (ADHydro::catchmentAggregation || 0.0 < ADHydro::rasterAggregationCellSize)
+    {
+      for (itMesh = meshElements.begin(); itMesh != meshElements.end(); ++itMesh)
+        {
+          record.time                     = currentTime;
+          record.zoneX                    = (*itMesh).second.catchment;
+          record.zoneY                    = 0;
+          record.area                     = (*itMesh).second.elementArea;
+          record.surfacewaterVolume       = (*itMesh).second.surfacewaterDepth * (*itMesh).second.elementArea;
+          record.groundwaterHeadTimesArea = (*itMesh).second.underground.groundwaterHead * (*itMesh).second.elementArea;
+          record.precipitationVolume      = ((*itMesh).second.precipitationCumulativeShortTerm + (*itMesh).second.precipitationCumulativeLongTerm) *
+                                            (*itMesh).second.elementArea;
+          record.evaporationVolume        = ((*itMesh).second.evaporationCumulativeShortTerm + (*itMesh).second.evaporationCumulativeLongTerm) *
+                                            (*itMesh).second.elementArea;
+          record.transpirationVolume      = ((*itMesh).second.transpirationCumulativeShortTerm + (*itMesh).second.transpirationCumulativeLongTerm) *
+                                            (*itMesh).second.elementArea;
+          
+          if (ADHydro::catchmentAggregation)
+            {
+              it = catchments.find(std::pair<int, int>(record.zoneX, record.zoneY));
+              
+              if (catchments.end() == it)
+                {
+                  catchments[std::pair<int, int>(record.zoneX, record.zoneY)] = record;
+                }
+              else
+                {
+                  (*it).second.add(record);
+                }
+            }
+          
+          if (0.0 < ADHydro::rasterAggregationCellSize)
+            {
+              // Each element is assigned entirely to the cell containing its center.
+              record.zoneX = (int)floor((*itMesh).second.elementX / ADHydro::rasterAggregationCellSize);
+              record.zoneY = (int)floor((*itMesh).second.elementY / ADHydro::rasterAggregationCellSize);
+              it           = cells.find(std::pair<int, int>(record.zoneX, record.zoneY));
+              
+              if (cells.end() == it)
+                {
+                  cells[std::pair<int, int>(record.zoneX, record.zoneY)] = record;
+                }
+              else
+                {
+                  (*it).second.add(record);
+                }
+            }
+        }
+      
+      // A region with no mesh elements contributes a single record with zero area.  See the comment on AggregateRecord.
+      record.time                     = currentTime;
+      record.zoneX                    = 0;
+      record.zoneY                    = 0;
+      record.area                     = 0.0;
+      record.surfacewaterVolume       = 0.0;
+      record.groundwaterHeadTimesArea = 0.0;
+      record.precipitationVolume      = 0.0;
+      record.evaporationVolume        = 0.0;
+      record.transpirationVolume      = 0.0;
+    }
+  
+  if (ADHydro::catchmentAggregation)
+    {
+      records.clear();
+      
+      for (it = catchments.begin(); it != catchments.end(); ++it)
+        {
+          records.push_back((*it).second);
+        }
+      
+      if (records.empty())
+        {
+          records.push_back(record);
+        }
+      
+      contribute(records.size() * sizeof(AggregateRecord), &records[0], CkReduction::set,
+                 CkCallback(CkIndex_FileManager::writeCatchmentAggregates(NULL), ADHydro::fileManagerProxy[0]));
+    }
+  
+  if (0.0 < ADHydro::rasterAggregationCellSize)
+    {
+      records.clear();
+      
+      for (it = cells.begin(); it != cells.end(); ++it)
+        {
+          records.push_back((*it).second);
+        }
+      
+      if (records.empty())
+        {
+          records.push_back(record);
+        }
+      
+      contribute(records.size() * sizeof(AggregateRecord), &records[0], CkReduction::set,
+                 CkCallback(CkIndex_FileManager::writeRasterAggregates(NULL), ADHydro::fileManagerProxy[0]));
+    }
 }
 
 bool Region::allForcingUpdated()
@@ -614,9 +614,16 @@ public:
   // end of the timestep.
   void receiveInflowsAndAdvanceTime();
   
-  // FIXME comment
+  // Send element state to the file managers for output and flush buffered
+  // hydrographs on this PE to file.
   void sendStateToFileManagers();
   
+  // Sum mesh element state by catchment and by raster cell and contribute the
+  // sums to reductions that are written to file by the file manager on PE 0.
+  // Does nothing for each kind of aggregation that is turned off.  All regions
+  // must call this at the same simulation times.
+  void contributeAggregates();
+  
   // Scan elements to see if all forcing data has been updated.
   //
   // Returns: true if all forcing data has been updated, false otherwise.
@@ -748,6 +755,7 @@ public:
   bool   needToCheckInvariant; // Flag to indicate if the invariant needs tobe checked.
   int    nextCheckpointIndex;  // This multiplied by ADHydro::checkpointPeriod is the next time that a checkpoint will be done.
   int    nextOutputIndex;      // This multiplied by ADHydro::outputPeriod is the next time that an output will be done.
+  int    syncCount;            // The number of sync points passed so far.  Used to do the mass balance every ADHydro::massBalanceInterval sync points.
   bool   simulationFinished;   // Flag to indicate the simulation is finished.
   double nextForcingDataTime;  // Simulation time to receive the next forcing data in seconds since ADHydro::referenceDate.
   
@@ -334,11 +334,11 @@ bool surfacewaterMeshMeshFlowRate(double* flowRate, double* dtNew, double edgeLe
       CkAssert(0.0 < averageDepth && 0.0 != headSlope);
 #endif // (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
       
-      *flowRate = (pow(averageDepth, 5.0 / 3.0) / (averageManningsN * sqrt(fabs(headSlope)))) * headSlope * edgeLength;
+      *flowRate = (powFiveThirds(averageDepth) / (averageManningsN * sqrt(fabs(headSlope)))) * headSlope * edgeLength;
 
       // Suggest new timestep.
-      dtTemp = COURANT_DIFFUSIVE * sqrt(2.0 * averageArea) / (pow(averageDepth, 2.0 / 3.0) * sqrt(fabs(headSlope)) / averageManningsN + sqrt(GRAVITY *
-                                                                                                                                             averageDepth));
+      dtTemp = COURANT_DIFFUSIVE * sqrt(2.0 * averageArea) / (powTwoThirds(averageDepth) * sqrt(fabs(headSlope)) / averageManningsN + sqrt(GRAVITY *
+                                                                                                                                           averageDepth));
 
       if (*dtNew > dtTemp)
         {
@@ -616,7 +616,7 @@ void surfacewaterStreamStreamFlowRate(double* flowRate, double* dtNew, double el
       
       averageRadius     = 0.5 * (elementRadius + neighborRadius);
       velocityDirection = (0.0 <= headSlope) ? 1.0 : -1.0;
-      velocityMagnitude = pow(averageRadius, 2.0 / 3.0) * sqrt(fabs(headSlope)) / averageManningsN;
+      velocityMagnitude = powTwoThirds(averageRadius) * sqrt(fabs(headSlope)) / averageManningsN;
       criticalVelocity  = sqrt(GRAVITY * averageDepth);
       
       // diffusive wave flow assumes small velocities.  Cap the velocity at the critical velocity.
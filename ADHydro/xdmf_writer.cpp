@@ -0,0 +1,300 @@
+#include "xdmf_writer.h"
+#include "file_manager.h"
+
+// Which NetCDF file an XDMF attribute comes from.
+enum XDMFSourceEnum
+{
+  XDMF_SOURCE_GEOMETRY,
+  XDMF_SOURCE_PARAMETER,
+  XDMF_SOURCE_DATA, // The state or display file.
+};
+
+// Description of one scalar attribute in an XDMF grid.
+struct XDMFAttribute
+{
+  XDMFSourceEnum source;      // Which NetCDF file the attribute comes from.
+  const char*    name;        // Variable name in the NetCDF file.
+  const char*    dataType;    // XDMF data type.
+  int            precision;   // XDMF precision in bytes.
+  bool           displayOnly; // If true the variable is in the display file but not the state file.
+};
+
+// Attributes of each mesh element grid.  These are the same as in util/adhydro_create_xdmf_file.cpp.
+static const XDMFAttribute meshAttributes[] =
+{
+  {XDMF_SOURCE_GEOMETRY,  "meshElementX",                         "Float", 8, false},
+  {XDMF_SOURCE_GEOMETRY,  "meshElementY",                         "Float", 8, false},
+  {XDMF_SOURCE_GEOMETRY,  "meshElementZSurface",                  "Float", 8, false},
+  {XDMF_SOURCE_GEOMETRY,  "meshElementSoilDepth",                 "Float", 8, false},
+  {XDMF_SOURCE_GEOMETRY,  "meshElementLayerZBottom",              "Float", 8, false},
+  {XDMF_SOURCE_GEOMETRY,  "meshElementArea",                      "Float", 8, false},
+  {XDMF_SOURCE_GEOMETRY,  "meshElementSlopeX",                    "Float", 8, false},
+  {XDMF_SOURCE_GEOMETRY,  "meshElementSlopeY",                    "Float", 8, false},
+  {XDMF_SOURCE_GEOMETRY,  "meshLatitude",                         "Float", 8, false},
+  {XDMF_SOURCE_GEOMETRY,  "meshLongitude",                        "Float", 8, false},
+  {XDMF_SOURCE_PARAMETER, "meshRegion",                           "Int",   4, false},
+  {XDMF_SOURCE_PARAMETER, "meshCatchment",                        "Int",   4, false},
+  {XDMF_SOURCE_PARAMETER, "meshVegetationType",                   "Int",   4, false},
+  {XDMF_SOURCE_PARAMETER, "meshSoilType",                         "Int",   4, false},
+  {XDMF_SOURCE_PARAMETER, "meshAlluvium",                         "Int",   1, false},
+  {XDMF_SOURCE_PARAMETER, "meshManningsN",                        "Float", 8, false},
+  {XDMF_SOURCE_PARAMETER, "meshConductivity",                     "Float", 8, false},
+  {XDMF_SOURCE_PARAMETER, "meshPorosity",                         "Float", 8, false},
+  {XDMF_SOURCE_PARAMETER, "meshGroundwaterMethod",                "Int",   4, false},
+  {XDMF_SOURCE_DATA,      "meshSurfacewaterDepth",                "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "meshSurfacewaterError",                "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "meshGroundwaterHead",                  "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "meshGroundwaterRecharge",              "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "meshGroundwaterError",                 "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "meshPrecipitationRate",                "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "meshPrecipitationCumulativeShortTerm", "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "meshPrecipitationCumulativeLongTerm",  "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "meshEvaporationRate",                  "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "meshEvaporationCumulativeShortTerm",   "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "meshEvaporationCumulativeLongTerm",    "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "meshTranspirationRate",                "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "meshTranspirationCumulativeShortTerm", "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "meshTranspirationCumulativeLongTerm",  "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "meshCanopyWater",                      "Float", 8, true},
+  {XDMF_SOURCE_DATA,      "meshSnowWaterEquivalent",              "Float", 8, true},
+};
+
+// Attributes of each channel element grid.  These are the same as in util/adhydro_create_xdmf_file.cpp.
+static const XDMFAttribute channelAttributes[] =
+{
+  {XDMF_SOURCE_GEOMETRY,  "channelElementX",                         "Float", 8, false},
+  {XDMF_SOURCE_GEOMETRY,  "channelElementY",                         "Float", 8, false},
+  {XDMF_SOURCE_GEOMETRY,  "channelElementZBank",                     "Float", 8, false},
+  {XDMF_SOURCE_GEOMETRY,  "channelElementBankFullDepth",             "Float", 8, false},
+  {XDMF_SOURCE_GEOMETRY,  "channelElementZBed",                      "Float", 8, false},
+  {XDMF_SOURCE_GEOMETRY,  "channelElementLength",                    "Float", 8, false},
+  {XDMF_SOURCE_GEOMETRY,  "channelLatitude",                         "Float", 8, false},
+  {XDMF_SOURCE_GEOMETRY,  "channelLongitude",                        "Float", 8, false},
+  {XDMF_SOURCE_PARAMETER, "channelRegion",                           "Int",   4, false},
+  {XDMF_SOURCE_PARAMETER, "channelChannelType",                      "Int",   4, false},
+  {XDMF_SOURCE_PARAMETER, "channelReachCode",                        "Int",   8, false},
+  {XDMF_SOURCE_PARAMETER, "channelBaseWidth",                        "Float", 8, false},
+  {XDMF_SOURCE_PARAMETER, "channelSideSlope",                        "Float", 8, false},
+  {XDMF_SOURCE_PARAMETER, "channelBedConductivity",                  "Float", 8, false},
+  {XDMF_SOURCE_PARAMETER, "channelBedThickness",                     "Float", 8, false},
+  {XDMF_SOURCE_PARAMETER, "channelManningsN",                        "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "channelSurfacewaterDepth",                "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "channelSurfacewaterError",                "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "channelPrecipitationRate",                "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "channelPrecipitationCumulativeShortTerm", "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "channelPrecipitationCumulativeLongTerm",  "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "channelEvaporationRate",                  "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "channelEvaporationCumulativeShortTerm",   "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "channelEvaporationCumulativeLongTerm",    "Float", 8, false},
+  {XDMF_SOURCE_DATA,      "channelSnowWaterEquivalent",              "Float", 8, true},
+};
+
+XDMFWriter::XDMFWriter() :
+  display(false),
+  meshFilePath(),
+  channelFilePath(),
+  geometrySource(),
+  parameterSource(),
+  dataSource(),
+  instances()
+{
+  // Initialization will be done in initialize.
+}
+
+// Returns: filePath relative to directoryPath if it is in directoryPath,
+//          otherwise filePath unchanged.
+static std::string relativePath(const std::string& directoryPath, const std::string& filePath)
+{
+  std::string prefix = directoryPath + "/"; // filePath must start with this to be in directoryPath.
+
+  if (0 == filePath.compare(0, prefix.size(), prefix))
+    {
+      return filePath.substr(prefix.size());
+    }
+  else
+    {
+      return filePath;
+    }
+}
+
+void XDMFWriter::initialize(bool displayInit, const std::string& directoryPath, const std::string& geometryFilePath, const std::string& parameterFilePath,
+                            const std::string& dataFilePath)
+{
+  display         = displayInit;
+  meshFilePath    = directoryPath + (display ? "/mesh_display.xdmf"    : "/mesh_state.xdmf");
+  channelFilePath = directoryPath + (display ? "/channel_display.xdmf" : "/channel_state.xdmf");
+  geometrySource  = relativePath(directoryPath, geometryFilePath);
+  parameterSource = relativePath(directoryPath, parameterFilePath);
+  dataSource      = relativePath(directoryPath, dataFilePath);
+
+  instances.clear();
+}
+
+void XDMFWriter::addInstance(double currentTime, size_t geometryInstance, size_t parameterInstance, size_t instance, int numberOfMeshNodes,
+                             int numberOfMeshElements, int numberOfChannelNodes, int numberOfChannelElements)
+{
+  std::vector<XDMFInstance>::size_type ii = 0; // Loop counter.
+
+  while (ii < instances.size() && instances[ii].instance != instance)
+    {
+      ++ii;
+    }
+
+  if (ii == instances.size())
+    {
+      instances.push_back(XDMFInstance());
+    }
+
+  instances[ii].currentTime             = currentTime;
+  instances[ii].geometryInstance        = geometryInstance;
+  instances[ii].parameterInstance       = parameterInstance;
+  instances[ii].instance                = instance;
+  instances[ii].numberOfMeshNodes       = numberOfMeshNodes;
+  instances[ii].numberOfMeshElements    = numberOfMeshElements;
+  instances[ii].numberOfChannelNodes    = numberOfChannelNodes;
+  instances[ii].numberOfChannelElements = numberOfChannelElements;
+}
+
+bool XDMFWriter::write(size_t geometryInstancesSize, size_t parameterInstancesSize, size_t instancesSize)
+{
+  bool error = false; // Error flag.
+
+  if (!instances.empty())
+    {
+      error = writeFile(true, geometryInstancesSize, parameterInstancesSize, instancesSize);
+
+      if (!error)
+        {
+          error = writeFile(false, geometryInstancesSize, parameterInstancesSize, instancesSize);
+        }
+    }
+
+  return error;
+}
+
+bool XDMFWriter::writeFile(bool mesh, size_t geometryInstancesSize, size_t parameterInstancesSize, size_t instancesSize)
+{
+  bool                                 error              = false;                                                      // Error flag.
+  const std::string&                   filePath           = (mesh ? meshFilePath : channelFilePath);                    // The XDMF file to write.
+  std::string                          tempFilePath       = filePath + ".tmp";                                          // Written first and then renamed.
+  const XDMFAttribute*                 attributes         = (mesh ? meshAttributes : channelAttributes);                // Attributes to write.
+  size_t                               numberOfAttributes = (mesh ? sizeof(meshAttributes) / sizeof(XDMFAttribute) :
+                                                                    sizeof(channelAttributes) / sizeof(XDMFAttribute)); // Number of entries in attributes.
+  const char*                          verticesName       = (mesh ? "meshElementVertices" : "channelElementVertices");  // Topology variable name.
+  size_t                               verticesSize       = (mesh ? MESH_ELEMENT_MESH_NEIGHBORS_SIZE : XDMF_SIZE);      // Second dimension of vertices.
+  const char*                          nodeNames[3];                                                                    // Geometry variable names.
+  std::vector<XDMFInstance>::size_type ii;                                                                              // Loop counter.
+  size_t                               jj;                                                                              // Loop counter.
+  int                                  numberOfNodes;                                                                   // Number of nodes in one grid.
+  int                                  numberOfElements;                                                                // Number of elements in one grid.
+  const char*                          source;                                                                          // Source file of one attribute.
+  size_t                               instance;                                                                        // Instance of one attribute.
+  size_t                               sourceInstancesSize;                                                             // Number of instances in source.
+  FILE*                                xdmfFile;                                                                        // The XDMF file to write.
+
+  nodeNames[0] = (mesh ? "meshNodeX"        : "channelNodeX");
+  nodeNames[1] = (mesh ? "meshNodeY"        : "channelNodeY");
+  nodeNames[2] = (mesh ? "meshNodeZSurface" : "channelNodeZBank");
+  xdmfFile     = fopen(tempFilePath.c_str(), "w");
+
+#if (DEBUG_LEVEL & DEBUG_LEVEL_LIBRARY_ERRORS)
+  if (!(NULL != xdmfFile))
+    {
+      CkError("ERROR in XDMFWriter::writeFile: could not open XDMF file %s.\n", tempFilePath.c_str());
+      error = true;
+    }
+#endif // (DEBUG_LEVEL & DEBUG_LEVEL_LIBRARY_ERRORS)
+
+  if (!error)
+    {
+      fprintf(xdmfFile, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+      fprintf(xdmfFile, "<!DOCTYPE Xdmf SYSTEM \"Xdmf.dtd\">\n");
+      fprintf(xdmfFile, "<Xdmf Version=\"2.0\" xmlns:xi=\"http://www.w3.org/2001/XInclude\">\n");
+      fprintf(xdmfFile, "  <Domain>\n");
+      fprintf(xdmfFile, "    <Grid GridType=\"Collection\" CollectionType=\"Temporal\" Name=\"%s%s\">\n", (mesh ? "Mesh" : "Channel"),
+              (display ? "Display" : "State"));
+
+      for (ii = 0; ii < instances.size(); ++ii)
+        {
+          numberOfNodes    = (mesh ? instances[ii].numberOfMeshNodes    : instances[ii].numberOfChannelNodes);
+          numberOfElements = (mesh ? instances[ii].numberOfMeshElements : instances[ii].numberOfChannelElements);
+
+          fprintf(xdmfFile, "      <Grid GridType=\"Uniform\">\n");
+          fprintf(xdmfFile, "        <Time Value=\"%lf\"/>\n", instances[ii].currentTime);
+
+          // Topology and geometry.
+          fprintf(xdmfFile, "        <Topology NumberOfElements=\"%d\" Type=\"%s\">\n", numberOfElements, (mesh ? "Triangle" : "Mixed"));
+          fprintf(xdmfFile, "          <DataItem ItemType=\"HyperSlab\" Dimensions=\"%d %zu\" Type=\"HyperSlab\">\n", numberOfElements, verticesSize);
+          fprintf(xdmfFile, "            <DataItem Dimensions=\"3 3\" Format=\"XML\">%zu 0 0 1 1 1 1 %d %zu</DataItem>\n", instances[ii].geometryInstance,
+                  numberOfElements, verticesSize);
+          fprintf(xdmfFile, "            <DataItem DataType=\"Int\" Dimensions=\"%zu %d %zu\" Format=\"HDF\">%s:/%s</DataItem>\n", geometryInstancesSize,
+                  numberOfElements, verticesSize, geometrySource.c_str(), verticesName);
+          fprintf(xdmfFile, "          </DataItem>\n");
+          fprintf(xdmfFile, "        </Topology>\n");
+          fprintf(xdmfFile, "        <Geometry Type=\"X_Y_Z\">\n");
+
+          for (jj = 0; jj < 3; ++jj)
+            {
+              fprintf(xdmfFile, "          <DataItem ItemType=\"HyperSlab\" Dimensions=\"%d\" Type=\"HyperSlab\">\n", numberOfNodes);
+              fprintf(xdmfFile, "            <DataItem Dimensions=\"3 2\" Format=\"XML\">%zu 0 1 1 1 %d</DataItem>\n", instances[ii].geometryInstance,
+                      numberOfNodes);
+              fprintf(xdmfFile, "            <DataItem DataType=\"Float\" Dimensions=\"%zu %d\" Format=\"HDF\" Precision=\"8\">%s:/%s</DataItem>\n",
+                      geometryInstancesSize, numberOfNodes, geometrySource.c_str(), nodeNames[jj]);
+              fprintf(xdmfFile, "          </DataItem>\n");
+            }
+
+          fprintf(xdmfFile, "        </Geometry>\n");
+
+          // Scalar attributes.
+          for (jj = 0; jj < numberOfAttributes; ++jj)
+            {
+              if (display || !attributes[jj].displayOnly)
+                {
+                  switch (attributes[jj].source)
+                  {
+                  case XDMF_SOURCE_GEOMETRY:
+                    source              = geometrySource.c_str();
+                    instance            = instances[ii].geometryInstance;
+                    sourceInstancesSize = geometryInstancesSize;
+                    break;
+                  case XDMF_SOURCE_PARAMETER:
+                    source              = parameterSource.c_str();
+                    instance            = instances[ii].parameterInstance;
+                    sourceInstancesSize = parameterInstancesSize;
+                    break;
+                  default: // case XDMF_SOURCE_DATA:
+                    source              = dataSource.c_str();
+                    instance            = instances[ii].instance;
+                    sourceInstancesSize = instancesSize;
+                    break;
+                  }
+
+                  fprintf(xdmfFile, "        <Attribute AttributeType=\"Scalar\" Center=\"Cell\" Name=\"%s\">\n", attributes[jj].name);
+                  fprintf(xdmfFile, "          <DataItem ItemType=\"HyperSlab\" Dimensions=\"%d\" Type=\"HyperSlab\">\n", numberOfElements);
+                  fprintf(xdmfFile, "            <DataItem Dimensions=\"3 2\" Format=\"XML\">%zu 0 1 1 1 %d</DataItem>\n", instance, numberOfElements);
+                  fprintf(xdmfFile, "            <DataItem DataType=\"%s\" Dimensions=\"%zu %d\" Format=\"HDF\" Precision=\"%d\">%s:/%s</DataItem>\n",
+                          attributes[jj].dataType, sourceInstancesSize, numberOfElements, attributes[jj].precision, source, attributes[jj].name);
+                  fprintf(xdmfFile, "          </DataItem>\n");
+                  fprintf(xdmfFile, "        </Attribute>\n");
+                }
+            }
+
+          fprintf(xdmfFile, "      </Grid>\n");
+        }
+
+      fprintf(xdmfFile, "    </Grid>\n");
+      fprintf(xdmfFile, "  </Domain>\n");
+      fprintf(xdmfFile, "</Xdmf>\n");
+
+      fclose(xdmfFile);
+
+      // Replace the old file in one step so that a reader never sees a partially written file.
+      if (0 != rename(tempFilePath.c_str(), filePath.c_str()))
+        {
+          CkError("ERROR in XDMFWriter::writeFile: could not rename %s to %s.\n", tempFilePath.c_str(), filePath.c_str());
+          error = true;
+        }
+    }
+
+  return error;
+}
@@ -0,0 +1,110 @@
+#ifndef __XDMF_WRITER_H__
+#define __XDMF_WRITER_H__
+
+#include "all_charm.h"
+#include <vector>
+
+// An XDMFInstance records what is needed to describe one instance of the
+// state or display file in XDMF.
+class XDMFInstance
+{
+public:
+
+  double currentTime;             // Simulation time of the instance in seconds since ADHydro::referenceDate.
+  size_t geometryInstance;        // Instance in the geometry file that the instance uses.
+  size_t parameterInstance;       // Instance in the parameter file that the instance uses.
+  size_t instance;                // Instance in the state or display file.
+  int    numberOfMeshNodes;       // Number of mesh nodes in the geometry instance.
+  int    numberOfMeshElements;    // Number of mesh elements in the geometry instance.
+  int    numberOfChannelNodes;    // Number of channel nodes in the geometry instance.
+  int    numberOfChannelElements; // Number of channel elements in the geometry instance.
+};
+
+// In order to read the NetCDF output files in paraview, it is necessary to
+// have XDMF files that describe them.  An XDMFWriter keeps the XDMF files for
+// either the state file or the display file up to date as the simulation runs
+// so that the output can be visualized while the simulation is still running
+// without a post-processing pass.  Only the file manager on PE 0 uses its
+// XDMFWriters.
+//
+// The XDMF files are a temporal collection of one grid per instance written by
+// this run.  Each grid refers to the data in the NetCDF files with HDF
+// hyperslabs so the XDMF files contain only metadata, which is small enough to
+// regenerate from memory each time an instance is added.  The files are written
+// to a temporary file and then renamed so that a reader never sees a partially
+// written file.  util/adhydro_create_xdmf_file.cpp can still be used to
+// generate XDMF files that cover all instances in the NetCDF files including
+// ones from previous runs.
+class XDMFWriter
+{
+public:
+
+  // Constructor.  The writer is initialized to have no instances.  initialize
+  // must be called before write.
+  XDMFWriter();
+
+  // Set the file paths.  The XDMF files are named mesh_state.xdmf and
+  // channel_state.xdmf, or mesh_display.xdmf and channel_display.xdmf, in
+  // directoryPath.  NetCDF files in directoryPath are referred to by file name
+  // only so that the directory can be moved.  Other NetCDF files are referred
+  // to by the paths passed in.
+  //
+  // Parameters:
+  //
+  // displayInit       - Whether this writer describes the display file, which
+  //                     has some variables that the state file does not.
+  // directoryPath     - Directory to write the XDMF files in.
+  // geometryFilePath  - Path of the geometry NetCDF file.
+  // parameterFilePath - Path of the parameter NetCDF file.
+  // dataFilePath      - Path of the state or display NetCDF file.
+  void initialize(bool displayInit, const std::string& directoryPath, const std::string& geometryFilePath, const std::string& parameterFilePath,
+                  const std::string& dataFilePath);
+
+  // Add an instance to the collection.  If an instance with the same instance
+  // number was already added it is replaced because the file manager
+  // overwrites instances with the same time.  Does not write to file.
+  //
+  // Parameters:
+  //
+  // Parameters directly initialize XDMFInstance member variables.  For
+  // description see XDMFInstance member variables.
+  void addInstance(double currentTime, size_t geometryInstance, size_t parameterInstance, size_t instance, int numberOfMeshNodes, int numberOfMeshElements,
+                   int numberOfChannelNodes, int numberOfChannelElements);
+
+  // Rewrite the mesh and channel XDMF files with all instances added so far.
+  // Does nothing if no instances have been added.
+  //
+  // Returns: true if there is an error, false otherwise.
+  //
+  // Parameters:
+  //
+  // geometryInstancesSize  - Number of instances in the geometry file.
+  // parameterInstancesSize - Number of instances in the parameter file.
+  // instancesSize          - Number of instances in the state or display file.
+  bool write(size_t geometryInstancesSize, size_t parameterInstancesSize, size_t instancesSize);
+
+private:
+
+  // Write one XDMF file.
+  //
+  // Returns: true if there is an error, false otherwise.
+  //
+  // Parameters:
+  //
+  // mesh                   - Whether to write the mesh file or the channel
+  //                          file.
+  // geometryInstancesSize  - Number of instances in the geometry file.
+  // parameterInstancesSize - Number of instances in the parameter file.
+  // instancesSize          - Number of instances in the state or display file.
+  bool writeFile(bool mesh, size_t geometryInstancesSize, size_t parameterInstancesSize, size_t instancesSize);
+
+  bool                      display;         // Whether the data file is the display file.
+  std::string               meshFilePath;    // Path of the mesh XDMF file.
+  std::string               channelFilePath; // Path of the channel XDMF file.
+  std::string               geometrySource;  // Path of the geometry NetCDF file as it appears in the XDMF files.
+  std::string               parameterSource; // Path of the parameter NetCDF file as it appears in the XDMF files.
+  std::string               dataSource;      // Path of the state or display NetCDF file as it appears in the XDMF files.
+  std::vector<XDMFInstance> instances;       // Instances in the collection in the order they were added.
+};
+
+#endif // __XDMF_WRITER_H__
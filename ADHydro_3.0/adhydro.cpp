@@ -110,16 +110,25 @@ ADHydro::ADHydro(CkArgMsg* msg)
             if (!error)
             {
                 // Get readonly variables from the superfile.
-                Readonly::simulationStartTime     = superfile.GetReal(   "", "simulationStartTime",     NAN);
-                Readonly::simulationDuration      = superfile.GetReal(   "", "simulationDuration",      NAN);
-                Readonly::checkpointPeriod        = superfile.GetReal(   "", "checkpointPeriod",        INFINITY);
-                Readonly::checkpointGroupSize     = superfile.GetInteger("", "checkpointGroupSize",     1);
-                Readonly::checkpointDirectoryPath = superfile.Get(       "", "checkpointDirectoryPath", ".");
-                Readonly::drainDownMode           = superfile.GetBoolean("", "drainDownMode",           false);
-                Readonly::zeroExpirationTime      = superfile.GetBoolean("", "zeroExpirationTime",      false);
-                Readonly::zeroCumulativeFlow      = superfile.GetBoolean("", "zeroCumulativeFlow",      false);
-                Readonly::zeroWaterCreated        = superfile.GetBoolean("", "zeroWaterCreated",        false);
-                Readonly::verbosityLevel          = superfile.GetInteger("", "verbosityLevel",          2);
+                Readonly::simulationStartTime      = superfile.GetReal(   "", "simulationStartTime",      NAN);
+                Readonly::simulationDuration       = superfile.GetReal(   "", "simulationDuration",       NAN);
+                Readonly::checkpointPeriod         = superfile.GetReal(   "", "checkpointPeriod",         INFINITY);
+                Readonly::checkpointGroupSize      = superfile.GetInteger("", "checkpointGroupSize",      1);
+                Readonly::checkpointDirectoryPath  = superfile.Get(       "", "checkpointDirectoryPath",  ".");
+                Readonly::checkpointFullInterval   = superfile.GetInteger("", "checkpointFullInterval",   1);
+                Readonly::checkpointDeltaThreshold = superfile.GetReal(   "", "checkpointDeltaThreshold", 0.0);
+                Readonly::forcingGroupSize         = superfile.GetInteger("", "forcingGroupSize",         1);
+                Readonly::invariantCheckInterval   = superfile.GetInteger("", "invariantCheckInterval",   (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_INVARIANTS) ? 1 : 0);
+                Readonly::invariantSampleStride    = superfile.GetInteger("", "invariantSampleStride",    1);
+                Readonly::evapoTranspirationPeriod = superfile.GetReal(   "", "evapoTranspirationPeriod", 0.0);
+                Readonly::groundwaterImplicitDt    = superfile.GetReal(   "", "groundwaterImplicitDt",    0.0);
+                Readonly::channelImplicitDt        = superfile.GetReal(   "", "channelImplicitDt",        0.0);
+                Readonly::flowRateStateTolerance   = superfile.GetReal(   "", "flowRateStateTolerance",   0.0);
+                Readonly::drainDownMode            = superfile.GetBoolean("", "drainDownMode",            false);
+                Readonly::zeroExpirationTime       = superfile.GetBoolean("", "zeroExpirationTime",       false);
+                Readonly::zeroCumulativeFlow       = superfile.GetBoolean("", "zeroCumulativeFlow",       false);
+                Readonly::zeroWaterCreated         = superfile.GetBoolean("", "zeroWaterCreated",         false);
+                Readonly::verbosityLevel           = superfile.GetInteger("", "verbosityLevel",           2);
                 
                 // At this point, Readonly::referenceDate, Readonly::simulationStartTime, and Readonly::simulationDuration could all be NAN.
                 // If Readonly::simulationDuration is NAN it is an error, which will be caught when we call Readonly::checkInvariant().
@@ -148,6 +157,24 @@ ADHydro::ADHydro(CkArgMsg* msg)
                     Readonly::checkpointGroupSize = 1;
                 }
                 
+                // Same for checkpointFullInterval.
+                if (0 == Readonly::checkpointFullInterval)
+                {
+                    Readonly::checkpointFullInterval = 1;
+                }
+                
+                // Same for forcingGroupSize.
+                if (0 == Readonly::forcingGroupSize)
+                {
+                    Readonly::forcingGroupSize = 1;
+                }
+                
+                // Same for invariantSampleStride.
+                if (0 == Readonly::invariantSampleStride)
+                {
+                    Readonly::invariantSampleStride = 1;
+                }
+                
                 // Read the number of regions from file to create the correct size array of Region chares.
                 Readonly::globalNumberOfRegions = 2; // FIXME read the real value
                 
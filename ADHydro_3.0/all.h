@@ -80,8 +80,25 @@
 #define DEBUG_LEVEL_ALL (DEBUG_LEVEL_LIBRARY_ERRORS | DEBUG_LEVEL_USER_INPUT_SIMPLE | DEBUG_LEVEL_USER_INPUT_INVARIANTS | DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE | DEBUG_LEVEL_PUBLIC_FUNCTIONS_INVARIANTS | \
     DEBUG_LEVEL_PRIVATE_FUNCTIONS_SIMPLE | DEBUG_LEVEL_PRIVATE_FUNCTIONS_INVARIANTS | DEBUG_LEVEL_INTERNAL_SIMPLE | DEBUG_LEVEL_INTERNAL_INVARIANTS)
 
-// Set this macro to the debug level to use.
+// Set this macro to the debug level to use.  The default is
+// DEBUG_LEVEL_DEVELOPMENT.  It can be overridden with -DDEBUG_LEVEL=<level> in
+// the compiler flags.  The adhydro-release target in the makefile uses
+// DEBUG_LEVEL_PRODUCTION_EXECUTABLE so that the checks in constructors and
+// other hot path functions compile out entirely.  The invariant checks at sync
+// times are not controlled by this macro.  See Readonly::invariantCheckInterval.
+#ifndef DEBUG_LEVEL
 #define DEBUG_LEVEL (DEBUG_LEVEL_DEVELOPMENT)
+#endif // DEBUG_LEVEL
+
+// Set this macro to nonzero to calculate the fractional powers in Manning's
+// equation with powTwoThirds and powFiveThirds below using cbrt instead of
+// pow.  cbrt is several times faster than pow and its results differ from pow
+// by no more than a few units in the last place.  The default is zero, which
+// uses pow and reproduces previous results exactly.  It can be overridden with
+// -DFAST_FRACTIONAL_POWERS=1 in EXTRAFLAGS in the makefile.
+#ifndef FAST_FRACTIONAL_POWERS
+#define FAST_FRACTIONAL_POWERS (0)
+#endif // FAST_FRACTIONAL_POWERS
 
 // Constants.
 #define GRAVITY               (9.81)               // (m/s^2)
@@ -227,6 +244,33 @@ inline bool epsilonEqual(float a, float b, float epsilonProxy = 0.0)
   return !epsilonLess(a, b, epsilonProxy) && !epsilonGreater(a, b, epsilonProxy);
 }
 
+// Utility functions for the fixed fractional powers used in Manning's
+// equation.  x must be non-negative.
+
+// Returns: x raised to the two thirds power.
+inline double powTwoThirds(double x)
+{
+#if (FAST_FRACTIONAL_POWERS)
+  double cubeRoot = cbrt(x); // x raised to the one third power.
+  
+  return cubeRoot * cubeRoot;
+#else // (FAST_FRACTIONAL_POWERS)
+  return pow(x, 2.0 / 3.0);
+#endif // (FAST_FRACTIONAL_POWERS)
+}
+
+// Returns: x raised to the five thirds power.
+inline double powFiveThirds(double x)
+{
+#if (FAST_FRACTIONAL_POWERS)
+  double cubeRoot = cbrt(x); // x raised to the one third power.
+  
+  return x * cubeRoot * cubeRoot;
+#else // (FAST_FRACTIONAL_POWERS)
+  return pow(x, 5.0 / 3.0);
+#endif // (FAST_FRACTIONAL_POWERS)
+}
+
 // Utility functions for converting dates.
 
 // Convert Gregorian date to Julian date.
@@ -86,6 +86,20 @@ bool ChannelElement::checkInvariant() const
         CkError("ERROR in ChannelElement::checkInvariant, element %lu: surfaceWater must be greater than or equal to zero.\n", elementNumber);
         error = true;
     }
+    else
+    {
+        if (!(crossSectionalAreaFromSurfaceWaterDepth(surfaceWater) == surfaceWaterCrossSectionalArea))
+        {
+            CkError("ERROR in ChannelElement::checkInvariant, element %lu: surfaceWaterCrossSectionalArea must be consistent with surfaceWater.\n", elementNumber);
+            error = true;
+        }
+        
+        if (!(baseWidth + 2.0 * sideSlope * surfaceWater == surfaceWaterTopWidth))
+        {
+            CkError("ERROR in ChannelElement::checkInvariant, element %lu: surfaceWaterTopWidth must be consistent with surfaceWater.\n", elementNumber);
+            error = true;
+        }
+    }
     
     if (!(0.0 >= precipitationRate))
     {
@@ -105,6 +119,24 @@ bool ChannelElement::checkInvariant() const
         error = true;
     }
     
+    if (!(0.0 < evapoTranspirationStepDuration))
+    {
+        CkError("ERROR in ChannelElement::checkInvariant, element %lu: evapoTranspirationStepDuration must be greater than zero.\n", elementNumber);
+        error = true;
+    }
+    
+    if (!(0.0 >= evapoTranspirationPrecipitation))
+    {
+        CkError("ERROR in ChannelElement::checkInvariant, element %lu: evapoTranspirationPrecipitation must be less than or equal to zero.\n", elementNumber);
+        error = true;
+    }
+    
+    if (!(0.0 <= evapoTranspirationSurfacewaterAdd))
+    {
+        CkError("ERROR in ChannelElement::checkInvariant, element %lu: evapoTranspirationSurfacewaterAdd must be greater than or equal to zero.\n", elementNumber);
+        error = true;
+    }
+    
     for (it = neighbors.begin(); it != neighbors.end(); ++it)
     {
         error = it->first.checkInvariant()  || error;
@@ -226,24 +258,16 @@ bool ChannelElement::sendNeighborAttributes(std::map<size_t, std::vector<Neighbo
     return error;
 }
 
-bool ChannelElement::sendNeighborInvariant(std::map<size_t, std::vector<InvariantMessage> >& outgoingMessages, size_t& elementsFinished)
+bool ChannelElement::sendNeighborInvariant(std::map<size_t, std::vector<InvariantMessage> >& outgoingMessages, double currentTime) const
 {
-    bool                                                  error = false; // Error flag.
-    std::map<NeighborConnection, NeighborProxy>::iterator it;            // Loop iterator.
+    bool                                                        error = false; // Error flag.
+    std::map<NeighborConnection, NeighborProxy>::const_iterator it;            // Loop iterator.
     
     // Don't error check parameters because it's a simple pass-through to NeighborProxy::sendInvariantMessage and it will be checked inside that method.
     
-    neighborsFinished = 0;
-    
     for (it = neighbors.begin(); !error && it != neighbors.end(); ++it)
     {
-        error = it->second.sendInvariantMessage(outgoingMessages, neighborsFinished, it->first);
-    }
-    
-    // Check if this element is finished.
-    if (!error && neighbors.size() == neighborsFinished)
-    {
-        ++elementsFinished;
+        error = it->second.sendInvariantMessage(outgoingMessages, it->first, currentTime);
     }
     
     return error;
@@ -272,32 +296,17 @@ bool ChannelElement::calculateNominalFlowRates(std::map<size_t, std::vector<Stat
     return error;
 }
 
-bool ChannelElement::doPointProcessesAndSendOutflows(std::map<size_t, std::vector<WaterMessage> >& outgoingMessages, size_t& elementsFinished, double currentTime, double timestepEndTime)
+bool ChannelElement::doPointProcessesAndSendOutflows(std::map<size_t, std::vector<WaterMessage> >& outgoingMessages, size_t& elementsFinished, double currentTime, double timestepEndTime,
+                                                     double evapoTranspirationLimitTime, SolarGeometry& solarGeometry)
 {
     bool   error                = false;                         // Error flag.
-    double localSolarDateTime   = Readonly::referenceDate + (currentTime / ONE_DAY_IN_SECONDS) + (longitude / (2.0 * M_PI)); // (days) Julian date converted from UTC to local solar time.
-    long   year;                                                 // For calculating yearlen, julian, and hourAngle.
-    long   month;                                                // For calculating hourAngle.
-    long   day;                                                  // For calculating hourAngle.
-    long   hour;                                                 // For passing to julianToGregorian, unused.
-    long   minute;                                               // For passing to julianToGregorian, unused.
-    double second;                                               // For passing to julianToGregorian, unused.
-    int    yearlen;                                              // (days) Year length.
-    float  julian;                                               // (days) Day of year including fractional day.
-    double hourAngle;                                            // (radians) How far the sun is east or west of zenith.  Positive means west.  Negative means east.  Used for calculating cosZ.
-    double declinationOfSun;                                     // (radians) How far the sun is above the horizon.  Used for calculating cosZ.
-    float  cosZ;                                                 // Cosine of the angle between the normal to the land surface and the sun.
-    double originalEvapoTranspirationTotalWaterInDomain;         // (mm) For mass balance check.
     double dt                   = timestepEndTime - currentTime; // (s) Duration of timestep.
-    float  surfacewaterAdd;                                      // (mm) Water from Noah-MP that must be added to surface water.  Must be non-negative.
-    float  evaporationFromSnow;                                  // (mm) Water that Noah-MP already added to or removed from the snowpack for evaporation or condensation.
-                                                                 // Positive means water evaporated off of the snowpack.  Negative means water condensed on to the snowpack.
-    float  evaporationFromGround;                                // (mm) Water that must be added to or removed from the land surface for evaporation or condensation.
-                                                                 // Positive means water evaporated off of the ground.  Negative means water condensed on to the ground.
-    float  noahMPWaterCreated;                                   // (mm) Water that was created or destroyed by Noah-MP.  Positive means water was created.  Negative means water was destroyed.
-    double topWidth             = baseWidth + 2.0 * sideSlope * surfaceWater; // (m) Width of the water top surface.
+    double evapoTranspirationDt;                                 // (s) Duration of the part of this timestep covered by one evapotranspiration step.
+    double newStepStartTime;                                     // (s) Simulation time at the start of a new evapotranspiration step.
+    double surfacewaterAdd;                                      // (m) Water from Noah-MP that must be added to surface water.  Must be non-negative.
+    double topWidth             = surfaceWaterTopWidth;          // (m) Width of the water top surface.
     double topArea              = topWidth * elementLength;      // (m^2) Surface area of the water top surface.
-    double crossSectionalArea   = crossSectionalAreaFromSurfaceWaterDepth(surfaceWater); // (m^2) Wetted cross sectional area of the channel.
+    double crossSectionalArea   = surfaceWaterCrossSectionalArea; // (m^2) Wetted cross sectional area of the channel.
     double precipitation;                                        // (m) Total quantity of water precipitated this timestep.
     double evaporation;                                          // (m) Total quantity of water evaporated   this timestep.
     double unsatisfiedEvaporation;                               // (m) Remaining quantity of water needing to be evaporated.
@@ -316,82 +325,44 @@ bool ChannelElement::doPointProcessesAndSendOutflows(std::map<size_t, std::vecto
     
     if (!error)
     {
-        // Calculate year, month, and day.  Hour, minute, and second are unused.
-        julianToGregorian(localSolarDateTime, &year, &month, &day, &hour, &minute, &second);
-        
-        // Determine if it is a leap year.
-        if (0 == year % 400)
-        {
-            yearlen = 366;
-        }
-        else if (0 == year % 100)
-        {
-            yearlen = 365;
-        }
-        else if (0 == year % 4)
-        {
-            yearlen = 366;
-        }
-        else
-        {
-            yearlen = 365;
-        }
+        // Apply whatever is left of the current evapotranspiration step.  Before the first step evapoTranspirationStepEndTime is negative infinity so nothing is applied.
+        evapoTranspirationDt   = std::max(0.0, std::min(timestepEndTime, evapoTranspirationStepEndTime) - currentTime);
+        precipitation          = evapoTranspirationPrecipitation     * (evapoTranspirationDt / evapoTranspirationStepDuration);
+        surfacewaterAdd        = evapoTranspirationSurfacewaterAdd   * (evapoTranspirationDt / evapoTranspirationStepDuration);
+        evaporation            = evapoTranspirationEvaporation       * (evapoTranspirationDt / evapoTranspirationStepDuration);
+        unsatisfiedEvaporation = evapoTranspirationGroundEvaporation * (evapoTranspirationDt / evapoTranspirationStepDuration);
         
-        // Calculate the ordinal day of the year by subtracting the Julian date of Jan 1 beginning midnight.
-        julian = localSolarDateTime - gregorianToJulian(year, 1, 1, 0, 0, 0.0);
-        
-        if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
-        {
-            CkAssert(0.0f <= julian && julian < yearlen);
-        }
-        
-        // Calculate cosZ.
-        // FIXME handle slope, aspect, and long distance shading effects on solar radiation by modifying how cosZ is calculated.
-        hourAngle        = (localSolarDateTime - gregorianToJulian(year, month, day, 12, 0, 0.0)) * 2.0 * M_PI;
-        declinationOfSun = -23.44 * (M_PI / 180.0) * cos(2.0 * M_PI * (julian + 10.0) / yearlen);
-        cosZ             = sin(latitude) * sin(declinationOfSun) + cos(latitude) * cos(declinationOfSun) * cos(hourAngle);
-        
-        if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
-        {
-            CkAssert(-1.0f <= cosZ && 1.0f >= cosZ);
-        }
-        
-        // If the sun is below the horizon it doesn't matter how far below.  Set cosZ to zero.
-        if (0.0f > cosZ)
-        {
-            cosZ = 0.0f;
-        }
-        
-        // Save the original amount of water stored in evapoTranspirationState for mass balance check.
-        originalEvapoTranspirationTotalWaterInDomain = evapoTranspirationTotalWaterInDomain(&evapoTranspirationState);
-        
-        // Call Noah-MP.
-        // FIXME Currently this is double counting area.  Streams overlap with adjacent mesh elements and both precipitate and evaporate that area.
-        if (ICEMASS == channelType)
+        // If the current evapotranspiration step ends before this timestep does start a new one.  The new step always covers the rest of this timestep so Noah-MP is called at most once
+        // per timestep.  With an evapoTranspirationPeriod of zero every evapotranspiration step is exactly one timestep.
+        if (evapoTranspirationStepEndTime < timestepEndTime)
         {
-            error = evapoTranspirationGlacier(cosZ, dt, &evapoTranspirationForcing, &evapoTranspirationState, &surfacewaterAdd, &evaporationFromSnow, &evaporationFromGround, &noahMPWaterCreated);
-        }
-        else
-        {
-            error = evapoTranspirationWater(latitude, yearlen, julian, cosZ, dt, elementLength, surfaceWater * 1000.0, &evapoTranspirationForcing,
-                                            &evapoTranspirationState, &surfacewaterAdd, &evaporationFromSnow, &evaporationFromGround, &noahMPWaterCreated);
+            newStepStartTime = std::max(currentTime, evapoTranspirationStepEndTime);
+            error            = doEvapoTranspirationStep(newStepStartTime, std::max(timestepEndTime, std::min(newStepStartTime + Readonly::evapoTranspirationPeriod, evapoTranspirationLimitTime)),
+                                                        solarGeometry);
+            
+            if (!error && 0.0 == Readonly::evapoTranspirationPeriod)
+            {
+                // The step is exactly this timestep so use the Noah-MP totals directly.  Nothing was applied above because the previous step ended at currentTime.
+                precipitation          = evapoTranspirationPrecipitation;
+                surfacewaterAdd        = evapoTranspirationSurfacewaterAdd;
+                evaporation            = evapoTranspirationEvaporation;
+                unsatisfiedEvaporation = evapoTranspirationGroundEvaporation;
+            }
+            else if (!error)
+            {
+                evapoTranspirationDt    = timestepEndTime - newStepStartTime;
+                precipitation          += evapoTranspirationPrecipitation     * (evapoTranspirationDt / evapoTranspirationStepDuration);
+                surfacewaterAdd        += evapoTranspirationSurfacewaterAdd   * (evapoTranspirationDt / evapoTranspirationStepDuration);
+                evaporation            += evapoTranspirationEvaporation       * (evapoTranspirationDt / evapoTranspirationStepDuration);
+                unsatisfiedEvaporation += evapoTranspirationGroundEvaporation * (evapoTranspirationDt / evapoTranspirationStepDuration);
+            }
         }
     }
     
     if (!error)
     {
-        // Because Noah-MP uses single precision floats, its roundoff error is much higher than for doubles.  However, we can calculate the mass error using doubles and account for it in surfaceWaterCreated.  The mass error
-        // is the amount of water at the end (water stored in evapoTranspirationState plus water that came out in the form of surfacewaterAdd and evaporationFromSnow) minus the amount of water at the beginning (water stored
-        // in evapoTranspirationState plus water that went in in the form of precipitation).  evaporationFromGround is not used in this computation because that water was not taken out by Noah-MP. It is taken below.
-        // Noah-MP also tells us if it knowingly created or destroyed any water in noahMPWaterCreated.  However, we don't use that value because this calculation subsumes that quantity at higher precision.
-        surfaceWaterCreated += ((((double)evapoTranspirationTotalWaterInDomain(&evapoTranspirationState) + (double)surfacewaterAdd + (double)evaporationFromSnow) -
-                                 (originalEvapoTranspirationTotalWaterInDomain + evapoTranspirationForcing.prcp * dt)) / 1000.0) * topArea; // Divide by a thousand to convert from millimeters to meters.
-        
-        // Add surfaceWater and record the quantities of precipitation and evaporation for this timestep.
-        crossSectionalArea      += (surfacewaterAdd / 1000.0) * topWidth;         // Divide by a thousand to convert from millimeters to meters.
-        precipitation            = -evapoTranspirationForcing.prcp * dt / 1000.0; // Divide by a thousand to convert from millimeters to meters.
-        evaporation              = evaporationFromSnow / 1000.0;                  // Divide by a thousand to convert from millimeters to meters.
-        unsatisfiedEvaporation   = evaporationFromGround / 1000.0;                // Divide by a thousand to convert from millimeters to meters.
+        // Add water from Noah-MP to surfaceWater.
+        crossSectionalArea += surfacewaterAdd * topWidth;
         
         // Take evaporation from surfaceWater.  If there isn't enough surfaceWater print a warning and reduce the quantity of evaporation.
         if (crossSectionalArea     >= unsatisfiedEvaporation * topWidth)
@@ -495,7 +466,7 @@ bool ChannelElement::doPointProcessesAndSendOutflows(std::map<size_t, std::vecto
         }
         
         // Convert cross sectional area back to water depth.
-        surfaceWater = surfaceWaterDepthFromCrossSectionalArea(crossSectionalArea);
+        setSurfaceWaterFromCrossSectionalArea(crossSectionalArea);
     
         neighborsFinished = 0;
     }
@@ -592,21 +563,90 @@ bool ChannelElement::receiveInflowsAndUpdateState(double currentTime, double tim
         // Convert cross sectional area to water depth.
         if (0.0 != crossSectionalArea)
         {
-            surfaceWater = surfaceWaterDepthFromCrossSectionalArea(crossSectionalAreaFromSurfaceWaterDepth(surfaceWater) + crossSectionalArea);
+            setSurfaceWaterFromCrossSectionalArea(surfaceWaterCrossSectionalArea + crossSectionalArea);
         }
         
         // If in drainDownMode cut off surface water to channel bank depth.
         if (Readonly::drainDownMode && surfaceWater > elementZBank - elementZBed)
         {
-            crossSectionalArea   = crossSectionalAreaFromSurfaceWaterDepth(surfaceWater);
-            surfaceWater         = elementZBank - elementZBed;
-            surfaceWaterCreated -= (crossSectionalArea - crossSectionalAreaFromSurfaceWaterDepth(surfaceWater)) * elementLength;
+            crossSectionalArea   = surfaceWaterCrossSectionalArea;
+            setSurfaceWater(elementZBank - elementZBed);
+            surfaceWaterCreated -= (crossSectionalArea - surfaceWaterCrossSectionalArea) * elementLength;
         }
     }
     
     return error;
 }
 
+bool ChannelElement::doEvapoTranspirationStep(double stepStartTime, double stepEndTime, SolarGeometry& solarGeometry)
+{
+    bool   error                = false;                         // Error flag.
+    int    yearlen;                                              // (days) Year length.
+    float  julian;                                               // (days) Day of year including fractional day.
+    float  cosZ;                                                 // Cosine of the angle between the normal to the land surface and the sun.
+    double originalEvapoTranspirationTotalWaterInDomain;         // (mm) For mass balance check.
+    double dt                   = stepEndTime - stepStartTime;   // (s) Duration of evapotranspiration step.
+    float  surfacewaterAdd;                                      // (mm) Water from Noah-MP that must be added to surface water.  Must be non-negative.
+    float  evaporationFromSnow;                                  // (mm) Water that Noah-MP already added to or removed from the snowpack for evaporation or condensation.
+                                                                 // Positive means water evaporated off of the snowpack.  Negative means water condensed on to the snowpack.
+    float  evaporationFromGround;                                // (mm) Water that must be added to or removed from the land surface for evaporation or condensation.
+                                                                 // Positive means water evaporated off of the ground.  Negative means water condensed on to the ground.
+    float  noahMPWaterCreated;                                   // (mm) Water that was created or destroyed by Noah-MP.  Positive means water was created.  Negative means water was destroyed.
+    double topArea              = surfaceWaterTopWidth * elementLength; // (m^2) Surface area of the water top surface.
+    
+    if (DEBUG_LEVEL & DEBUG_LEVEL_PRIVATE_FUNCTIONS_SIMPLE)
+    {
+        if (!(stepStartTime < stepEndTime))
+        {
+            CkError("ERROR in ChannelElement::doEvapoTranspirationStep: stepStartTime must be less than stepEndTime.\n");
+            error = true;
+        }
+    }
+    
+    if (!error)
+    {
+        error = solarGeometry.calculate(Readonly::referenceDate + (stepStartTime / ONE_DAY_IN_SECONDS), longitude, sinLatitude, cosLatitude, yearlen, julian, cosZ);
+    }
+    
+    if (!error)
+    {
+        // Save the original amount of water stored in evapoTranspirationState for mass balance check.
+        originalEvapoTranspirationTotalWaterInDomain = evapoTranspirationTotalWaterInDomain(&evapoTranspirationState);
+        
+        // Call Noah-MP.
+        // FIXME Currently this is double counting area.  Streams overlap with adjacent mesh elements and both precipitate and evaporate that area.
+        if (ICEMASS == channelType)
+        {
+            error = evapoTranspirationGlacier(cosZ, dt, &evapoTranspirationForcing, &evapoTranspirationState, &surfacewaterAdd, &evaporationFromSnow, &evaporationFromGround, &noahMPWaterCreated);
+        }
+        else
+        {
+            error = evapoTranspirationWater(latitude, yearlen, julian, cosZ, dt, elementLength, surfaceWater * 1000.0, &evapoTranspirationForcing,
+                                            &evapoTranspirationState, &surfacewaterAdd, &evaporationFromSnow, &evaporationFromGround, &noahMPWaterCreated);
+        }
+    }
+    
+    if (!error)
+    {
+        // Because Noah-MP uses single precision floats, its roundoff error is much higher than for doubles.  However, we can calculate the mass error using doubles and account for it in surfaceWaterCreated.  The mass error
+        // is the amount of water at the end (water stored in evapoTranspirationState plus water that came out in the form of surfacewaterAdd and evaporationFromSnow) minus the amount of water at the beginning (water stored
+        // in evapoTranspirationState plus water that went in in the form of precipitation).  evaporationFromGround is not used in this computation because that water was not taken out by Noah-MP. It is taken in doPointProcessesAndSendOutflows.
+        // Noah-MP also tells us if it knowingly created or destroyed any water in noahMPWaterCreated.  However, we don't use that value because this calculation subsumes that quantity at higher precision.
+        surfaceWaterCreated += ((((double)evapoTranspirationTotalWaterInDomain(&evapoTranspirationState) + (double)surfacewaterAdd + (double)evaporationFromSnow) -
+                                 (originalEvapoTranspirationTotalWaterInDomain + evapoTranspirationForcing.prcp * dt)) / 1000.0) * topArea; // Divide by a thousand to convert from millimeters to meters.
+        
+        // Record the totals for the whole step.  doPointProcessesAndSendOutflows applies the fraction of them that falls in each hydrologic timestep.
+        evapoTranspirationStepEndTime       = stepEndTime;
+        evapoTranspirationStepDuration      = dt;
+        evapoTranspirationPrecipitation     = -evapoTranspirationForcing.prcp * dt / 1000.0; // Divide by a thousand to convert from millimeters to meters.
+        evapoTranspirationSurfacewaterAdd   = surfacewaterAdd / 1000.0;                      // Divide by a thousand to convert from millimeters to meters.
+        evapoTranspirationEvaporation       = evaporationFromSnow / 1000.0;                  // Divide by a thousand to convert from millimeters to meters.
+        evapoTranspirationGroundEvaporation = evaporationFromGround / 1000.0;                // Divide by a thousand to convert from millimeters to meters.
+    }
+    
+    return error;
+}
+
 double ChannelElement::surfaceWaterDepthFromCrossSectionalArea(double crossSectionalArea)
 {
     double depth;     // Return value.
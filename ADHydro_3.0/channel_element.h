@@ -2,6 +2,7 @@
 #define __CHANNEL_ELEMENT_H__
 
 #include "checkpoint_manager_data_types.h"
+#include "solar_geometry.h"
 
 // A ChannelElement is a length of stream, a waterbody, or a glacier in the channel network.  It is modeled as a linear element.
 // It simulates surfacewater state only.  Groundwater underneath the channel is simulated by neighboring mesh elements.
@@ -16,10 +17,12 @@ public:
                           double surfaceWater = 0.0, double surfaceWaterCreated = 0.0, double precipitationCumulative = 0.0, double evaporationCumulative = 0.0,
                           std::map<NeighborConnection, NeighborProxy> neighbors = std::map<NeighborConnection, NeighborProxy>()) :
         elementNumber(elementNumber), channelType(channelType), reachCode(reachCode), elementX(elementX), elementY(elementY), elementZBank(elementZBank),
-        elementZBed(elementZBed), elementLength(elementLength), latitude(latitude), longitude(longitude), baseWidth(baseWidth), sideSlope(sideSlope), manningsN(manningsN),
+        elementZBed(elementZBed), elementLength(elementLength), latitude(latitude), longitude(longitude), sinLatitude(sin(latitude)), cosLatitude(cos(latitude)), baseWidth(baseWidth), sideSlope(sideSlope), manningsN(manningsN),
         bedThickness(bedThickness), bedConductivity(bedConductivity), /* evapoTranspirationForcing and evapoTranspirationState initialized below. */ surfaceWater(surfaceWater),
-        surfaceWaterCreated(surfaceWaterCreated), precipitationRate(0.0), precipitationCumulativeShortTerm(0.0), precipitationCumulativeLongTerm(precipitationCumulative),
-        evaporationRate(0.0), evaporationCumulativeShortTerm(0.0), evaporationCumulativeLongTerm(evaporationCumulative), neighbors(neighbors), neighborsFinished(0)
+        surfaceWaterCrossSectionalArea((baseWidth + sideSlope * surfaceWater) * surfaceWater), surfaceWaterTopWidth(baseWidth + 2.0 * sideSlope * surfaceWater), surfaceWaterCreated(surfaceWaterCreated), precipitationRate(0.0), precipitationCumulativeShortTerm(0.0), precipitationCumulativeLongTerm(precipitationCumulative),
+        evaporationRate(0.0), evaporationCumulativeShortTerm(0.0), evaporationCumulativeLongTerm(evaporationCumulative),
+        evapoTranspirationStepEndTime(-INFINITY), evapoTranspirationStepDuration(1.0), evapoTranspirationPrecipitation(0.0), evapoTranspirationSurfacewaterAdd(0.0),
+        evapoTranspirationEvaporation(0.0), evapoTranspirationGroundEvaporation(0.0), neighbors(neighbors), neighborsFinished(0)
     {
         // Values for evapoTranspirationForcing are going to be received before we start simulating.  For now, just fill in values that will pass the invariant.
         evapoTranspirationForcing.dz8w   = 20.0f;
@@ -119,6 +122,8 @@ public:
         p | elementLength;
         p | latitude;
         p | longitude;
+        p | sinLatitude;
+        p | cosLatitude;
         p | baseWidth;
         p | sideSlope;
         p | manningsN;
@@ -127,6 +132,12 @@ public:
         p | evapoTranspirationForcing;
         p | evapoTranspirationState;
         p | surfaceWater;
+        
+        if (p.isUnpacking())
+        {
+            setSurfaceWater(surfaceWater);
+        }
+        
         p | surfaceWaterCreated;
         p | precipitationRate;
         p | precipitationCumulativeShortTerm;
@@ -134,6 +145,12 @@ public:
         p | evaporationRate;
         p | evaporationCumulativeShortTerm;
         p | evaporationCumulativeLongTerm;
+        p | evapoTranspirationStepEndTime;
+        p | evapoTranspirationStepDuration;
+        p | evapoTranspirationPrecipitation;
+        p | evapoTranspirationSurfacewaterAdd;
+        p | evapoTranspirationEvaporation;
+        p | evapoTranspirationGroundEvaporation;
         p | neighbors;
         p | neighborsFinished;
     }
@@ -165,15 +182,15 @@ public:
     // elementsFinished - Number of elements in the current Region finished in the initialization phase.  May be incremented if this call causes this element to be finished.
     bool sendNeighborAttributes(std::map<size_t, std::vector<NeighborMessage> >& outgoingMessages, size_t& elementsFinished);
     
-    // Call sendInvariantMessage on all NeighborProxies.
+    // Call sendInvariantMessage on all NeighborProxies.  Must be called before calculateNominalFlowRates in the same timestep.
     //
     // Returns: true if there is an error, false otherwise.
     //
     // Parameters:
     //
     // outgoingMessages - Container to aggregate outgoing messages to other Regions.  Key is Region ID number of message destination.
-    // elementsFinished - Number of elements in the current Region finished in the initialization phase.  May be incremented if this call causes this element to be finished.
-    bool sendNeighborInvariant(std::map<size_t, std::vector<InvariantMessage> >& outgoingMessages, size_t& elementsFinished);
+    // currentTime      - (s) Current simulation time specified as the number of seconds after referenceDate.  Can be negative to specify times before reference date.
+    bool sendNeighborInvariant(std::map<size_t, std::vector<InvariantMessage> >& outgoingMessages, double currentTime) const;
     
     // Call calculateNominalFlowRate on all NeighborProxies.
     //
@@ -206,11 +223,14 @@ public:
     //
     // Parameters:
     //
-    // outgoingMessages - Container to aggregate outgoing messages to other Regions.  Key is Region ID number of message destination.
-    // elementsFinished - Number of elements in the current Region finished in the receive water phase.  May be incremented if this call causes this element to be finished.
-    // currentTime      - (s) Current simulation time specified as the number of seconds after referenceDate.  Can be negative to specify times before reference date.
-    // timestepEndTime  - (s) Simulation time at the end of the current timestep specified as the number of seconds after referenceDate.  Can be negative to specify times before reference date.
-    bool doPointProcessesAndSendOutflows(std::map<size_t, std::vector<WaterMessage> >& outgoingMessages, size_t& elementsFinished, double currentTime, double timestepEndTime);
+    // outgoingMessages            - Container to aggregate outgoing messages to other Regions.  Key is Region ID number of message destination.
+    // elementsFinished            - Number of elements in the current Region finished in the receive water phase.  May be incremented if this call causes this element to be finished.
+    // currentTime                 - (s) Current simulation time specified as the number of seconds after referenceDate.  Can be negative to specify times before reference date.
+    // timestepEndTime             - (s) Simulation time at the end of the current timestep specified as the number of seconds after referenceDate.  Can be negative to specify times before reference date.
+    // evapoTranspirationLimitTime - (s) A new evapotranspiration step will not extend past this time unless it has to in order to cover timestepEndTime.
+    // solarGeometry               - The Region's solar geometry cache.
+    bool doPointProcessesAndSendOutflows(std::map<size_t, std::vector<WaterMessage> >& outgoingMessages, size_t& elementsFinished, double currentTime, double timestepEndTime,
+                                         double evapoTranspirationLimitTime, SolarGeometry& solarGeometry);
     
     // Recieve lateral inflows, move water through impedance layer, run aquifer capillary fringe solver, update water table heads, and resolve recharge.
     //
@@ -266,7 +286,7 @@ public:
             
             for (itProxy = neighbors.begin(), itState = state.neighbors.begin(); itProxy != neighbors.end(); ++itProxy, ++itState)
             {
-                if (DEBUG_LEVEL && DEBUG_LEVEL_INTERNAL_SIMPLE)
+                if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
                 {
                     // Because we resized state.neighbors we shouldn't run out of elements in this loop.
                     CkAssert(itState != state.neighbors.end());
@@ -275,7 +295,7 @@ public:
                 itProxy->second.fillInState(*itState, itProxy->first);
             }
             
-            if (DEBUG_LEVEL && DEBUG_LEVEL_INTERNAL_SIMPLE)
+            if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
             {
                 // Because we resized state.neighbors we should hit the end of both containers at the same time.
                 CkAssert(itState == state.neighbors.end());
@@ -291,6 +311,12 @@ public:
         return elementNumber;
     }
     
+    // Returns: the value of channelType.
+    inline ChannelTypeEnum getChannelType() const
+    {
+        return channelType;
+    }
+    
     // Sets forcing data.
     inline void setEvapoTranspirationForcing(const EvapoTranspirationForcingStruct& newEvapoTranspirationForcing)
     {
@@ -299,6 +325,18 @@ public:
     
 private:
     
+    // Call Noah-MP for one evapotranspiration step and record its fluxes in the evapoTranspiration total variables to be spread evenly over the step.
+    // Noah-MP's roundoff error for the whole step is accounted for in surfaceWaterCreated immediately.
+    //
+    // Returns: true if there is an error, false otherwise.
+    //
+    // Parameters:
+    //
+    // stepStartTime - (s) Simulation time at the start of the evapotranspiration step.
+    // stepEndTime   - (s) Simulation time at the end of the evapotranspiration step.  Also sets evapoTranspirationStepEndTime.
+    // solarGeometry - The Region's solar geometry cache.
+    bool doEvapoTranspirationStep(double stepStartTime, double stepEndTime, SolarGeometry& solarGeometry);
+    
     // Returns: (m) the surface water depth of a trapeziodal channel from the wetted cross sectional area.
     //
     // Parameters:
@@ -311,7 +349,7 @@ private:
     // Parameters:
     //
     // depth - (m) Surface water depth of the channel.
-    inline double crossSectionalAreaFromSurfaceWaterDepth(double depth)
+    inline double crossSectionalAreaFromSurfaceWaterDepth(double depth) const
     {
         if (DEBUG_LEVEL & DEBUG_LEVEL_PRIVATE_FUNCTIONS_SIMPLE)
         {
@@ -321,6 +359,30 @@ private:
         return (baseWidth + sideSlope * depth) * depth;
     }
     
+    // Set surfaceWater and update surfaceWaterCrossSectionalArea and surfaceWaterTopWidth to match.  All changes to surfaceWater after construction must go through this method or
+    // setSurfaceWaterFromCrossSectionalArea.
+    //
+    // Parameters:
+    //
+    // depth - (m) The new surface water depth of the channel.
+    inline void setSurfaceWater(double depth)
+    {
+        surfaceWater                   = depth;
+        surfaceWaterCrossSectionalArea = crossSectionalAreaFromSurfaceWaterDepth(surfaceWater);
+        surfaceWaterTopWidth           = baseWidth + 2.0 * sideSlope * surfaceWater;
+    }
+    
+    // Set surfaceWater from a wetted cross sectional area and update surfaceWaterCrossSectionalArea and surfaceWaterTopWidth to match.
+    // surfaceWater remains the authoritative state so the cached area is recalculated from the new depth rather than copied from crossSectionalArea.
+    //
+    // Parameters:
+    //
+    // crossSectionalArea - (m^2) The new wetted cross sectional area of the channel.
+    inline void setSurfaceWaterFromCrossSectionalArea(double crossSectionalArea)
+    {
+        setSurfaceWater(surfaceWaterDepthFromCrossSectionalArea(crossSectionalArea));
+    }
+    
     // Returns: the attributes of this element.
     inline NeighborAttributes localAttributes()
     {
@@ -338,6 +400,8 @@ private:
     double          elementLength;   // (m) 1D length of element ignoring slope.
     double          latitude;        // (radians)
     double          longitude;       // (radians)
+    double          sinLatitude;     // Sine   of latitude.  Precomputed for solar geometry.
+    double          cosLatitude;     // Cosine of latitude.  Precomputed for solar geometry.
     double          baseWidth;       // (m) Width of channel base.
     double          sideSlope;       // (m/m) Widening of each side of the channel for each unit increase in water depth.  It is delta-x over delta-y, the inverse of the traditional definition of slope.
                                      // The width of the channel at height h above elementZBed is baseWidth + 2.0 * sideSlope * h.
@@ -350,9 +414,11 @@ private:
     EvapoTranspirationForcingStruct evapoTranspirationForcing; // Data structure containing the forcing used by Noah-MP.
     
     // Mutable state of the element.
-    EvapoTranspirationStateStruct evapoTranspirationState; // Data structure containing the state used by Noah-MP.
-    double                        surfaceWater;            // (m) Depth of ponded surface water.
-    double                        surfaceWaterCreated;     // (m^3) Surface water created or destroyed for exceptional and possibly erroneous circumstances.  Positive means water was created.  Negative means water was destroyed.
+    EvapoTranspirationStateStruct evapoTranspirationState;        // Data structure containing the state used by Noah-MP.
+    double                        surfaceWater;                   // (m) Depth of ponded surface water.
+    double                        surfaceWaterCrossSectionalArea; // (m^2) Wetted cross sectional area of the channel.  Derived from surfaceWater and cached because it is needed several times per timestep.
+    double                        surfaceWaterTopWidth;           // (m) Width of the water top surface.  Derived from surfaceWater and cached because it is needed several times per timestep.
+    double                        surfaceWaterCreated;            // (m^3) Surface water created or destroyed for exceptional and possibly erroneous circumstances.  Positive means water was created.  Negative means water was destroyed.
     
     // These are variables for recording flows for point processes.  The rate variables are simple instantaneous rates.  The cumulative variables have some complexity with how they are stored.
     // For each cumulative quantity, flow is stored in two variables, a short term variable and a long term variable.  The purpose of this is to minimize roundoff error.
@@ -366,6 +432,14 @@ private:
     double evaporationCumulativeShortTerm;   // (m^3) Positive means water evaporated from the element.  Negative means water condensed on to the element.
     double evaporationCumulativeLongTerm;    // (m^3) Positive means water evaporated from the element.  Negative means water condensed on to the element.
     
+    // Noah-MP is called once per evapotranspiration step, which can span many hydrologic timesteps.  See the comments on the same variables in MeshElement.
+    double evapoTranspirationStepEndTime;       // (s) Simulation time at the end of the current evapotranspiration step.
+    double evapoTranspirationStepDuration;      // (s) Duration of the current evapotranspiration step.  Must be greater than zero.
+    double evapoTranspirationPrecipitation;     // (m) Precipitation that went into Noah-MP over the whole step.  Negative means water added to the element.  Must be non-positive.
+    double evapoTranspirationSurfacewaterAdd;   // (m) Water from Noah-MP over the whole step that must be added to surface water.  Must be non-negative.
+    double evapoTranspirationEvaporation;       // (m) Evaporation over the whole step that Noah-MP already took from the snowpack.  Negative means condensation.
+    double evapoTranspirationGroundEvaporation; // (m) Evaporation over the whole step that must be taken from surface water.  Negative means condensation.
+    
     // Neighbors of the element.
     std::map<NeighborConnection, NeighborProxy> neighbors;         // A map of NeighborProxies allowing the element to find a specific neighor or iterate over all neighbors.
                                                                    // Keys are NeighborConnection objects that uniquely identify each connection.
@@ -1,6 +1,147 @@
 #include "checkpoint_manager.h"
 #include "file_manager_NetCDF.h"
 
+bool CheckpointManager::writeFullCheckpoint()
+{
+    bool   error          = false;                                            // Error flag.
+    double checkpointTime = Readonly::getCheckpointTime(nextCheckpointIndex); // (s) The value of currentTime of the checkpoint.
+    
+    error = FileManagerNetCDF::writeState(checkpointTime, *checkpointData[nextCheckpointIndex], checkpointTime);
+    
+    if (!error)
+    {
+        if (1 < Readonly::checkpointFullInterval)
+        {
+            // Keep the full state as the basis for the following delta checkpoints.
+            delete lastWrittenState;
+            lastWrittenState       = checkpointData[nextCheckpointIndex];
+            lastFullCheckpointTime = checkpointTime;
+        }
+        else
+        {
+            delete checkpointData[nextCheckpointIndex]; // FIXME implement a pool of TimePointStates so we don't need to keep newing and deleting them.
+        }
+        
+        checkpointData[nextCheckpointIndex] = NULL;
+    }
+    
+    return error;
+}
+
+void CheckpointManager::contributeChangedElementCounts()
+{
+    size_t            ii;                                          // Loop counter.
+    TimePointState*   state = checkpointData[nextCheckpointIndex]; // The state to compare to lastWrittenState.
+    std::vector<long> counts(2 * CkNumPes(), 0);                   // Number of changed elements on each PE.  Mesh elements in the first half and channel elements in the second half.
+    
+    if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
+    {
+        CkAssert(NULL != state && NULL != lastWrittenState);
+    }
+    
+    meshElementChanged.assign(state->localNumberOfMeshElements, false);
+    channelElementChanged.assign(state->localNumberOfChannelElements, false);
+    
+    for (ii = 0; ii < state->localNumberOfMeshElements; ++ii)
+    {
+        if (state->meshElementChanged(ii, *lastWrittenState, ii, Readonly::checkpointDeltaThreshold))
+        {
+            meshElementChanged[ii] = true;
+            ++counts[CkMyPe()];
+        }
+    }
+    
+    for (ii = 0; ii < state->localNumberOfChannelElements; ++ii)
+    {
+        if (state->channelElementChanged(ii, *lastWrittenState, ii, Readonly::checkpointDeltaThreshold))
+        {
+            channelElementChanged[ii] = true;
+            ++counts[CkNumPes() + CkMyPe()];
+        }
+    }
+    
+    contribute(counts.size() * sizeof(long), &counts[0], CkReduction::sum_long, CkCallback(CkReductionTarget(CheckpointManager, changedElementCounts), thisProxy));
+}
+
+bool CheckpointManager::writeDeltaCheckpoint(int numberOfCounts, long* counts)
+{
+    bool            error                                = false;                               // Error flag.
+    int             ii;                                                                         // Loop counter.
+    size_t          jj, kk;                                                                     // Loop counters.
+    TimePointState* state                                = checkpointData[nextCheckpointIndex]; // The full state of the checkpoint.
+    TimePointState* deltaState;                                                                 // The changed elements of the checkpoint.
+    size_t          globalNumberOfChangedMeshElements    = 0;                                   // Total number of changed mesh    elements on all PEs.
+    size_t          changedMeshElementStart              = 0;                                   // Index in the delta file of the first changed mesh    element on this PE.
+    size_t          globalNumberOfChangedChannelElements = 0;                                   // Total number of changed channel elements on all PEs.
+    size_t          changedChannelElementStart           = 0;                                   // Index in the delta file of the first changed channel element on this PE.
+    
+    if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
+    {
+        if (!(2 * CkNumPes() == numberOfCounts))
+        {
+            CkError("ERROR in CheckpointManager::writeDeltaCheckpoint: numberOfCounts must be two times the number of PEs.\n");
+            error = true;
+        }
+    }
+    
+    if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
+    {
+        CkAssert(NULL != state && NULL != lastWrittenState);
+    }
+    
+    if (!error)
+    {
+        for (ii = 0; ii < CkNumPes(); ++ii)
+        {
+            if (ii < CkMyPe())
+            {
+                changedMeshElementStart    += counts[ii];
+                changedChannelElementStart += counts[CkNumPes() + ii];
+            }
+            
+            globalNumberOfChangedMeshElements    += counts[ii];
+            globalNumberOfChangedChannelElements += counts[CkNumPes() + ii];
+        }
+        
+        deltaState = new TimePointState(globalNumberOfChangedMeshElements, counts[CkMyPe()], changedMeshElementStart, state->maximumNumberOfMeshNeighbors,
+                                        globalNumberOfChangedChannelElements, counts[CkNumPes() + CkMyPe()], changedChannelElementStart, state->maximumNumberOfChannelNeighbors, true);
+        
+        // Copy changed elements into the delta and also into lastWrittenState so that later deltas are calculated against what a restart would see.
+        for (jj = 0, kk = 0; jj < state->localNumberOfMeshElements; ++jj)
+        {
+            if (meshElementChanged[jj])
+            {
+                deltaState->copyMeshElement(kk, *state, jj);
+                deltaState->meshElementNumber[kk] = state->localMeshElementStart + jj;
+                lastWrittenState->copyMeshElement(jj, *state, jj);
+                ++kk;
+            }
+        }
+        
+        for (jj = 0, kk = 0; jj < state->localNumberOfChannelElements; ++jj)
+        {
+            if (channelElementChanged[jj])
+            {
+                deltaState->copyChannelElement(kk, *state, jj);
+                deltaState->channelElementNumber[kk] = state->localChannelElementStart + jj;
+                lastWrittenState->copyChannelElement(jj, *state, jj);
+                ++kk;
+            }
+        }
+        
+        // The delta was filled in by copying rather than receiving state so mark it complete.
+        deltaState->elementsReceived = deltaState->localNumberOfMeshElements + deltaState->localNumberOfChannelElements;
+        
+        error = FileManagerNetCDF::writeState(Readonly::getCheckpointTime(nextCheckpointIndex), *deltaState, lastFullCheckpointTime);
+        
+        delete deltaState;
+        delete state; // FIXME implement a pool of TimePointStates so we don't need to keep newing and deleting them.
+        checkpointData[nextCheckpointIndex] = NULL;
+    }
+    
+    return error;
+}
+
 // Suppress warnings in the The Charm++ autogenerated code.
 #pragma GCC diagnostic ignored "-Wunused-variable"
 #include "checkpoint_manager.def.h"
@@ -15,7 +15,8 @@ class CheckpointManager : public CBase_CheckpointManager
 public:
     
     // Constructor.  Sets checkpointData to the proper size filled in with NULLs.
-    inline CheckpointManager() : checkpointData(Readonly::getNumberOfCheckpoints() + 1, NULL), nextCheckpointIndex(1), endOutputIndex(1)
+    inline CheckpointManager() : checkpointData(Readonly::getNumberOfCheckpoints() + 1, NULL), nextCheckpointIndex(1), endOutputIndex(1), lastWrittenState(NULL),
+                                 lastFullCheckpointTime(0.0), meshElementChanged(), channelElementChanged()
     {
         // FIXME if this OutputManager has no elements for a particular time point then it will never receive a message and it will hang.
         // We need to figure out some way to signal this condition and go on because it doesn't need to wait for data.
@@ -23,6 +24,19 @@ public:
         thisProxy[CkMyPe()].runUntilSimulationEnd();
     }
     
+    // Destructor.  lastWrittenState is never also in checkpointData because writeFullCheckpoint sets its slot to NULL.
+    inline ~CheckpointManager()
+    {
+        size_t ii; // Loop counter.
+        
+        for (ii = 0; ii < checkpointData.size(); ++ii)
+        {
+            delete checkpointData[ii];
+        }
+        
+        delete lastWrittenState;
+    }
+    
 private:
     
     // Returns: true if the CheckpointManager has all of the data it needs to output the next checkpoint(s).
@@ -41,9 +55,43 @@ private:
         return ready;
     }
     
-    std::vector<TimePointState*> checkpointData;      // Sets of data for different time points.  The size of checkpointData is the number of checkpoints plus one and checkpointData[0] is unused.
-    size_t                       nextCheckpointIndex; // The next index in checkpointData to output.  Goes from one to the number of checkpoints.
-    size_t                       endOutputIndex;      // Needed by SDAG code to span serial blocks.
+    // Returns: true if checkpoint nextCheckpointIndex should be written as a delta checkpoint, false if it should be written as a full checkpoint.
+    // The first checkpoint, every checkpointFullInterval'th checkpoint after that, and the last checkpoint are full.  The rest are delta.
+    inline bool isDeltaCheckpoint()
+    {
+        return (NULL != lastWrittenState && 0 != (nextCheckpointIndex - 1) % Readonly::checkpointFullInterval && checkpointData.size() - 1 > nextCheckpointIndex);
+    }
+    
+    // Write checkpoint nextCheckpointIndex as a full checkpoint and delete or keep its TimePointState.
+    //
+    // Returns: true if there is an error, false otherwise.
+    bool writeFullCheckpoint();
+    
+    // Find which elements of checkpoint nextCheckpointIndex changed since they were last written and contribute the number of changed elements on this PE to a
+    // reduction so that all PEs can calculate where to write their changed elements in the delta file.  Exit on error.
+    void contributeChangedElementCounts();
+    
+    // Write the changed elements of checkpoint nextCheckpointIndex as a delta checkpoint and update lastWrittenState.
+    //
+    // Returns: true if there is an error, false otherwise.
+    //
+    // Parameters:
+    //
+    // numberOfCounts - The size of counts.  Must be two times the number of PEs.
+    // counts         - The result of the reduction started by contributeChangedElementCounts.  Element i is the number of changed mesh elements on PE i.
+    //                  Element number of PEs plus i is the number of changed channel elements on PE i.
+    bool writeDeltaCheckpoint(int numberOfCounts, long* counts);
+    
+    std::vector<TimePointState*> checkpointData;         // Sets of data for different time points.  The size of checkpointData is the number of checkpoints plus one and checkpointData[0] is unused.
+    size_t                       nextCheckpointIndex;    // The next index in checkpointData to output.  Goes from one to the number of checkpoints.
+    size_t                       endOutputIndex;         // Needed by SDAG code to span serial blocks.
+    
+    // For delta checkpoints.
+    TimePointState*              lastWrittenState;       // The state a restart would reconstruct from the checkpoint files written so far.  Delta checkpoints are calculated against this.
+                                                         // NULL if no full checkpoint has been written yet, or if checkpointFullInterval is one so there are no delta checkpoints.
+    double                       lastFullCheckpointTime; // (s) The value of currentTime of the most recent full checkpoint.
+    std::vector<bool>            meshElementChanged;     // Needed by SDAG code to span serial blocks.  Whether each mesh    element will be written to the current delta checkpoint.
+    std::vector<bool>            channelElementChanged;  // Needed by SDAG code to span serial blocks.  Whether each channel element will be written to the current delta checkpoint.
 };
 
 #endif // __CHECKPOINT_MANAGER_H__
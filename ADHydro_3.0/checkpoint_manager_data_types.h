@@ -13,7 +13,9 @@
 // but we need to save their states in the input/output files as fixed size blobs.
 // These declarations provide fixed size blobs for that data.  Any new simulation module must shoehorn their state into a fixed size blob,
 // generally by providing a pup routine, and update the size definition to make sure it will fit.
-#define VADOSE_ZONE_STATE_BLOB_SIZE         (sizeof(SimpleVadoseZone))
+// The vadose zone blob holds only the five doubles that SimpleVadoseZone::pup packs.  It is not sizeof(SimpleVadoseZone) because SimpleVadoseZone also caches
+// saturationDepth, which is derived from water and must not change the size of the VadoseZoneState opaque type in the input/output files.
+#define VADOSE_ZONE_STATE_BLOB_SIZE         (5 * sizeof(double))
 #define EVAPO_TRANSPIRATION_STATE_BLOB_SIZE (sizeof(EvapoTranspirationStateStruct))
 
 typedef unsigned char VadoseZoneStateBlob[VADOSE_ZONE_STATE_BLOB_SIZE];
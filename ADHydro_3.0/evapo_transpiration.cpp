@@ -1,6 +1,7 @@
 #include "evapo_transpiration.h"
 #include "readonly.h"
 #include <cstring>
+#include <mutex>
 
 #ifdef INTEL_COMPILER
 #define READ_MP_VEG_PARAMETERS noahmp_veg_parameters_mp_read_mp_veg_parameters_
@@ -56,6 +57,43 @@ extern "C" void NOAHMP_GLACIER(int* iLoc, int* jLoc, float* cosZ, int* nSnow, in
                                float* ch2b);
 extern float NOAHMP_POROSITY;
 
+// Noah-MP passes values between its routines in Fortran module globals, and
+// these and the variables below are shared by all threads in the process.  In
+// Charm++ SMP mode several PEs call into this module at the same time so all
+// use of Noah-MP is serialized by noahMPMutex.  The parameter tables are read
+// once per process no matter how many PEs call evapoTranspirationInit.
+static std::mutex noahMPMutex;
+static bool       noahMPInitialized = false;
+
+// REDPRM copies the soil and vegetation parameters for one element from the
+// parameter tables into Noah-MP module globals.  The values it sets depend only
+// on vegType, soilType, slopeType, and isUrban so the globals already hold the
+// right values if those are the same as in the last call.  The Region processes
+// its elements in order of vegetation and soil type so most calls are skipped.
+// These record the arguments of the last call to REDPRM.  -1 means the globals
+// have not been set since the parameter tables were read.
+static int redprmVegType   = -1;
+static int redprmSoilType  = -1;
+static int redprmSlopeType = -1;
+static int redprmIsUrban   = -1;
+
+// Set Noah-MP globals for the given parameters, calling REDPRM only if they
+// are different from the last call.  noahMPMutex must be held.
+//
+// Parameters are passed through to REDPRM.
+static void setNoahMPParameters(int* vegType, int* soilType, int* slopeType, float* zSoil, int* nSoil, int* isUrban)
+{
+  if (*vegType != redprmVegType || *soilType != redprmSoilType || *slopeType != redprmSlopeType || *isUrban != redprmIsUrban)
+    {
+      REDPRM(vegType, soilType, slopeType, zSoil, nSoil, isUrban);
+      
+      redprmVegType   = *vegType;
+      redprmSoilType  = *soilType;
+      redprmSlopeType = *slopeType;
+      redprmIsUrban   = *isUrban;
+    }
+}
+
 bool evapoTranspirationInit(const char* mpTableFile, const char* vegParmFile, const char* soilParmFile, const char* genParmFile)
 {
   bool        error          = false;                    // Error flag.
@@ -63,6 +101,9 @@ bool evapoTranspirationInit(const char* mpTableFile, const char* vegParmFile, co
   const char* soil           = "STAS";                   // Soil type data set.
   int         verbosityLevel = Readonly::verbosityLevel; // For passing verbosity level into Noah-MP.  I'm not comfortable passing a class static variable by reference into foreign code.
   
+  // Only one thread may read the parameter tables.
+  std::lock_guard<std::mutex> noahMPLock(noahMPMutex);
+  
   // =====================================options for different schemes================================
   // From module_sf_noahmplsm.F
   
@@ -165,13 +206,21 @@ bool evapoTranspirationInit(const char* mpTableFile, const char* vegParmFile, co
     }
 #endif // (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
 
-  if (!error)
+  if (!error && !noahMPInitialized)
     {
       READ_MP_VEG_PARAMETERS(landUse, mpTableFile, strlen(landUse), strlen(mpTableFile));
       SOIL_VEG_GEN_PARM(landUse, soil, vegParmFile, soilParmFile, genParmFile, &verbosityLevel, strlen(landUse), strlen(soil), strlen(vegParmFile),
                         strlen(soilParmFile), strlen(genParmFile));
       NOAHMP_OPTIONS(&dveg, &optCrs, &optBtr, &optRun, &optSfc, &optFrz, &optInf, &optRad, &optAlb, &optSnf, &optTbot, &optStc);
       NOAHMP_OPTIONS_GLACIER(&dveg, &optCrs, &optBtr, &optRun, &optSfc, &optFrz, &optInf, &optRad, &optAlb, &optSnf, &optTbot, &optStc);
+      
+      // The parameter tables were just read so the Noah-MP globals must be set again by the next call to setNoahMPParameters.
+      redprmVegType   = -1;
+      redprmSoilType  = -1;
+      redprmSlopeType = -1;
+      redprmIsUrban   = -1;
+      
+      noahMPInitialized = true;
     }
   
   return error;
@@ -182,10 +231,14 @@ float evapoTranspirationTotalWaterInDomain(const EvapoTranspirationStateStruct*
   return evapoTranspirationState->canLiq + evapoTranspirationState->canIce + evapoTranspirationState->snEqv;
 }
 
-bool evapoTranspirationSoil(int vegType, int soilType, float lat, int yearLen, float julian, float cosZ, float dt, float dx,
-                            EvapoTranspirationForcingStruct* evapoTranspirationForcing, EvapoTranspirationSoilMoistureStruct* evapoTranspirationSoilMoisture,
-                            EvapoTranspirationStateStruct* evapoTranspirationState, float* surfacewaterAdd, float* evaporationFromCanopy,
-                            float* evaporationFromSnow, float* evaporationFromGround, float* transpiration, float* waterError)
+// The implementation of evapoTranspirationSoil.  noahMPMutex must be held.
+//
+// Parameters are the same as evapoTranspirationSoil.
+static bool evapoTranspirationSoilLocked(int vegType, int soilType, float lat, int yearLen, float julian, float cosZ, float dt, float dx,
+                                         EvapoTranspirationForcingStruct* evapoTranspirationForcing,
+                                         EvapoTranspirationSoilMoistureStruct* evapoTranspirationSoilMoisture,
+                                         EvapoTranspirationStateStruct* evapoTranspirationState, float* surfacewaterAdd, float* evaporationFromCanopy,
+                                         float* evaporationFromSnow, float* evaporationFromGround, float* transpiration, float* waterError)
 {
   bool  error = false; // Error flag.
   int   ii;            // Loop counter.
@@ -620,7 +673,7 @@ bool evapoTranspirationSoil(int vegType, int soilType, float lat, int yearLen, f
         }
       
       // Set Noah-MP globals.
-      REDPRM(&vegType, &soilType, &slopeType, zSoil, &nSoil, &isUrban);
+      setNoahMPParameters(&vegType, &soilType, &slopeType, zSoil, &nSoil, &isUrban);
       
 #if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_INVARIANTS)
       // Now that NOAHMP_POROSITY is set check that none of the soil moisture variables exceed porosity.
@@ -945,6 +998,50 @@ bool evapoTranspirationSoil(int vegType, int soilType, float lat, int yearLen, f
   return error;
 }
 
+bool evapoTranspirationSoil(int vegType, int soilType, float lat, int yearLen, float julian, float cosZ, float dt, float dx,
+                            EvapoTranspirationForcingStruct* evapoTranspirationForcing, EvapoTranspirationSoilMoistureStruct* evapoTranspirationSoilMoisture,
+                            EvapoTranspirationStateStruct* evapoTranspirationState, float* surfacewaterAdd, float* evaporationFromCanopy,
+                            float* evaporationFromSnow, float* evaporationFromGround, float* transpiration, float* waterError)
+{
+  // Noah-MP globals are set and used throughout so hold noahMPMutex for the whole call.
+  std::lock_guard<std::mutex> noahMPLock(noahMPMutex);
+  
+  return evapoTranspirationSoilLocked(vegType, soilType, lat, yearLen, julian, cosZ, dt, dx, evapoTranspirationForcing, evapoTranspirationSoilMoisture,
+                                      evapoTranspirationState, surfacewaterAdd, evaporationFromCanopy, evaporationFromSnow, evaporationFromGround, transpiration,
+                                      waterError);
+}
+
+bool evapoTranspirationSoilBatch(size_t numberOfColumns, EvapoTranspirationSoilColumnStruct* columns)
+{
+  bool   error = false; // Error flag.
+  size_t ii;            // Loop counter.
+  
+#if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
+  if (!(NULL != columns || 0 == numberOfColumns))
+    {
+      ADHYDRO_ERROR("ERROR in evapoTranspirationSoilBatch: columns must not be NULL.\n");
+      error = true;
+    }
+#endif // (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
+  
+  if (!error)
+    {
+      // Hold noahMPMutex once for the whole block.
+      std::lock_guard<std::mutex> noahMPLock(noahMPMutex);
+      
+      for (ii = 0; ii < numberOfColumns; ii++)
+        {
+          error = evapoTranspirationSoilLocked(columns[ii].vegType, columns[ii].soilType, columns[ii].lat, columns[ii].yearLen, columns[ii].julian,
+                                               columns[ii].cosZ, columns[ii].dt, columns[ii].dx, columns[ii].evapoTranspirationForcing,
+                                               &columns[ii].evapoTranspirationSoilMoisture, columns[ii].evapoTranspirationState, &columns[ii].surfacewaterAdd,
+                                               &columns[ii].evaporationFromCanopy, &columns[ii].evaporationFromSnow, &columns[ii].evaporationFromGround,
+                                               &columns[ii].transpiration, &columns[ii].waterError) || error;
+        }
+    }
+  
+  return error;
+}
+
 bool evapoTranspirationWater(float lat, int yearLen, float julian, float cosZ, float dt, float dx, float wsLake,
                              EvapoTranspirationForcingStruct* evapoTranspirationForcing, EvapoTranspirationStateStruct* evapoTranspirationState,
                              float* surfacewaterAdd, float* evaporationFromSnow, float* evaporationFromGround, float* waterError)
@@ -952,6 +1049,9 @@ bool evapoTranspirationWater(float lat, int yearLen, float julian, float cosZ, f
   bool error = false; // Error flag.
   int  ii;            // Loop counter.
   
+  // Noah-MP globals are set and used throughout so hold noahMPMutex for the whole call.
+  std::lock_guard<std::mutex> noahMPLock(noahMPMutex);
+  
   // Input parameters for redprm function.  Some are also used for sflx function.
   int   vegType   = 16;                                        // 'Water Bodies' from VEGPARM.TBL.
   int   soilType  = 14;                                        // 'WATER' from SOILPARM.TBL.
@@ -1304,7 +1404,7 @@ bool evapoTranspirationWater(float lat, int yearLen, float julian, float cosZ, f
         }
 
       // Set Noah-MP globals.
-      REDPRM(&vegType, &soilType, &slopeType, zSoil, &nSoil, &isUrban);
+      setNoahMPParameters(&vegType, &soilType, &slopeType, zSoil, &nSoil, &isUrban);
       
       // Set water content of the soil layers.  In waterbodies the watertable is always at the surface and everything is saturated.  The global variable
       // NOAHMP_POROSITY gets set in REDPRM so we can't do this before here.
@@ -1611,6 +1711,9 @@ bool evapoTranspirationGlacier(float cosZ, float dt, EvapoTranspirationForcingSt
   bool error = false; // Error flag.
   int  ii;            // Loop counter.
   
+  // Noah-MP globals are set and used throughout so hold noahMPMutex for the whole call.
+  std::lock_guard<std::mutex> noahMPLock(noahMPMutex);
+  
   // Input parameters for redprm function.  Some are also used for sflx function.
   int   vegType   = 24;                                        // 'Snow or Ice' from VEGPARM.TBL.
   int   soilType  = 16;                                        // 'OTHER(land-ice)' from SOILPARM.TBL.
@@ -1852,7 +1955,7 @@ bool evapoTranspirationGlacier(float cosZ, float dt, EvapoTranspirationForcingSt
         }
 
       // Set Noah-MP globals.
-      REDPRM(&vegType, &soilType, &slopeType, zSoil, &nSoil, &isUrban);
+      setNoahMPParameters(&vegType, &soilType, &slopeType, zSoil, &nSoil, &isUrban);
       
       // Set water content of the soil layers.  In glaciers the watertable is always at the surface and everything is saturated and frozen.  The global
       // variable NOAHMP_POROSITY gets set in REDPRM so we can't do this before here.
@@ -107,7 +107,18 @@ PUPbytes(EvapoTranspirationStateStruct);
 
 // Call this once to initialize the evapo-transpiration module before calling
 // any of the other functions.  It initializes globals so in a parallel
-// application it must be called once from each shared memory domain.
+// application it must be called at least once from each shared memory domain.
+// It may be called from more than one thread in the same shared memory domain.
+// The first call initializes the globals and later calls do nothing.  The
+// evapo-transpiration functions may also be called from more than one thread.
+// They are serialized internally because Noah-MP keeps values in globals.
+// This means that in Charm++ SMP mode all of the PEs in a process share the
+// evapo-transpiration throughput of a single core.  A PE that calls Noah-MP
+// while another PE is in it waits instead of doing other work.  A soil call
+// takes a few microseconds, so the waiting is only significant when
+// evapo-transpiration is a large fraction of the run time.  In that case use
+// one PE per process, or a longer evapoTranspirationPeriod so Noah-MP is
+// called less often.
 //
 // Returns: true if there is an error, false otherwise.
 //
@@ -204,6 +215,56 @@ bool evapoTranspirationSoil(int vegType, int soilType, float lat, int yearLen, f
                             EvapoTranspirationStateStruct* evapoTranspirationState, float* surfacewaterAdd, float* evaporationFromCanopy,
                             float* evaporationFromSnow, float* evaporationFromGround, float* transpiration, float* waterError);
 
+// The arguments of one call to evapoTranspirationSoil for passing a block of
+// columns to evapoTranspirationSoilBatch.  For descriptions of the fields see
+// the parameters of evapoTranspirationSoil.  evapoTranspirationSoilMoisture is
+// held by value so that the caller does not need to keep a separate struct for
+// each column.  The output fields are filled in by
+// evapoTranspirationSoilBatch.
+typedef struct
+{
+  // Inputs.
+  int                                  vegType;
+  int                                  soilType;
+  float                                lat;
+  int                                  yearLen;
+  float                                julian;
+  float                                cosZ;
+  float                                dt;
+  float                                dx;
+  EvapoTranspirationForcingStruct*     evapoTranspirationForcing;
+  EvapoTranspirationSoilMoistureStruct evapoTranspirationSoilMoisture;
+  EvapoTranspirationStateStruct*       evapoTranspirationState;
+  
+  // Outputs.
+  float                                surfacewaterAdd;
+  float                                evaporationFromCanopy;
+  float                                evaporationFromSnow;
+  float                                evaporationFromGround;
+  float                                transpiration;
+  float                                waterError;
+  
+  // Not used by evapoTranspirationSoilBatch.  The caller can use this to save
+  // evapoTranspirationTotalWaterInDomain before the call for a mass balance
+  // check.
+  float                                originalTotalWaterInDomain;
+} EvapoTranspirationSoilColumnStruct;
+
+// Calculate evapo-transpiration for a block of locations with a soil surface.
+// This gives the same results as calling evapoTranspirationSoil for each
+// column in order, but the per-call overhead of locking and of setting Noah-MP
+// parameters is paid once per block instead of once per column.  Blocks sorted
+// by vegType and soilType get the most benefit.
+//
+// Returns: true if there is an error in any column, false otherwise.  All
+// columns are processed even if there is an error in one of them.
+//
+// Parameters:
+//
+// numberOfColumns - The number of elements in columns.
+// columns         - Array of columns to process.  Outputs are filled in.
+bool evapoTranspirationSoilBatch(size_t numberOfColumns, EvapoTranspirationSoilColumnStruct* columns);
+
 // Calculate evapo-transpiration for a location with a water surface.  This
 // should be used for places permanently covered with surfacewater such as
 // waterbodies, not mesh elements that temporarily have surfacewater.  The
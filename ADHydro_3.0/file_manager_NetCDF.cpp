@@ -132,7 +132,7 @@ template <typename T> bool FileManagerNetCDF::readVariable(int fileID, const cha
     return error;
 }
 
-bool FileManagerNetCDF::writeState(double checkpointTime, const TimePointState& timePointState)
+bool FileManagerNetCDF::writeState(double checkpointTime, const TimePointState& timePointState, double baseCheckpointTime)
 {
     bool               error    = false;              // Error flag.
     int                ncErrorCode;                   // Return value of NetCDF functions.
@@ -167,7 +167,7 @@ bool FileManagerNetCDF::writeState(double checkpointTime, const TimePointState&
     {
         julianToGregorian(Readonly::referenceDate + (checkpointTime / ONE_DAY_IN_SECONDS), &year, &month, &day, &hour, &minute, &second, true);
         
-        filename << Readonly::checkpointDirectoryPath << "/state_" << std::setfill('0') << std::setw(4) << year << std::setw(2) << month << std::setw(2) << day
+        filename << Readonly::checkpointDirectoryPath << (timePointState.delta ? "/delta_" : "/state_") << std::setfill('0') << std::setw(4) << year << std::setw(2) << month << std::setw(2) << day
                  << std::setw(2) << hour << std::setw(2) << minute << std::fixed << std::setprecision(0) << std::setw(2) << second << ".nc";
         
         if (0 == CkMyPe() && 1 <= Readonly::verbosityLevel)
@@ -248,6 +248,21 @@ bool FileManagerNetCDF::writeState(double checkpointTime, const TimePointState&
         }
     }
     
+    // A delta file records which full state file it applies to.
+    if (!error && timePointState.delta)
+    {
+        ncErrorCode = nc_put_att_double(fileID, NC_GLOBAL, "baseCheckpointTime", NC_DOUBLE, 1, &baseCheckpointTime);
+        
+        if (DEBUG_LEVEL & DEBUG_LEVEL_LIBRARY_ERRORS)
+        {
+            if (!(NC_NOERR == ncErrorCode))
+            {
+                CkError("ERROR in FileManagerNetCDF::writeState: could not create attribute baseCheckpointTime.  NetCDF error message: %s.\n", nc_strerror(ncErrorCode));
+                error = true;
+            }
+        }
+    }
+    
     // Create dimenisons.
     if (!error && 0 < timePointState.globalNumberOfMeshElements)
     {
@@ -337,6 +352,17 @@ bool FileManagerNetCDF::writeState(double checkpointTime, const TimePointState&
     // Create variables.
     if (0 < timePointState.globalNumberOfMeshElements)
     {
+        if (!error && timePointState.delta)
+        {
+            if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
+            {
+                // Assumes size_t is 8 bytes when storing as NC_UINT64.
+                CkAssert(8 == sizeof(size_t));
+            }
+            
+            error = createVariable(fileID, "meshElementNumber", NC_UINT64, 1, meshElementsDimensionID, 0, NULL, "Element number of each changed mesh element in this delta file.");
+        }
+        
         if (!error)
         {
             error = createVariable(fileID, "meshEvapoTranspirationState", EvapoTranspirationStateTypeID, 1, meshElementsDimensionID, 0, NULL, "Opaque blob of evapotranspiration state in mesh elements.");
@@ -516,6 +542,17 @@ bool FileManagerNetCDF::writeState(double checkpointTime, const TimePointState&
     
     if (0 < timePointState.globalNumberOfChannelElements)
     {
+        if (!error && timePointState.delta)
+        {
+            if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
+            {
+                // Assumes size_t is 8 bytes when storing as NC_UINT64.
+                CkAssert(8 == sizeof(size_t));
+            }
+            
+            error = createVariable(fileID, "channelElementNumber", NC_UINT64, 1, channelElementsDimensionID, 0, NULL, "Element number of each changed channel element in this delta file.");
+        }
+        
         if (!error)
         {
             error = createVariable(fileID, "channelEvapoTranspirationState", EvapoTranspirationStateTypeID, 1, channelElementsDimensionID, 0, NULL, "Opaque blob of evapotranspiration state in channel elements.");
@@ -623,6 +660,11 @@ bool FileManagerNetCDF::writeState(double checkpointTime, const TimePointState&
     // Write variables.
     if (0 < timePointState.localNumberOfMeshElements)
     {
+        if (!error && timePointState.delta)
+        {
+            error = writeVariable(fileID, "meshElementNumber", timePointState.localMeshElementStart, timePointState.localNumberOfMeshElements, 0, timePointState.meshElementNumber);
+        }
+        
         if (!error)
         {
             error = writeVariable(fileID, "meshEvapoTranspirationState", timePointState.localMeshElementStart, timePointState.localNumberOfMeshElements, 0, timePointState.meshEvapoTranspirationState);
@@ -776,6 +818,11 @@ bool FileManagerNetCDF::writeState(double checkpointTime, const TimePointState&
     
     if (0 < timePointState.localNumberOfChannelElements)
     {
+        if (!error && timePointState.delta)
+        {
+            error = writeVariable(fileID, "channelElementNumber", timePointState.localChannelElementStart, timePointState.localNumberOfChannelElements, 0, timePointState.channelElementNumber);
+        }
+        
         if (!error)
         {
             error = writeVariable(fileID, "channelEvapoTranspirationState", timePointState.localChannelElementStart, timePointState.localNumberOfChannelElements, 0, timePointState.channelEvapoTranspirationState);
@@ -44,14 +44,18 @@ public:
     
     // Write a TimePointState out to a NetCDF file.  writeState does collective parallel I/O so you must call it from all processors simultaneously,
     // one call per processor, all outputing to the same file.  It will block until all processors attempt to open the same file.
+    // A full TimePointState is written to a file named state_<date>.nc.  A delta TimePointState is written to a file named delta_<date>.nc with the additional
+    // variables meshElementNumber and channelElementNumber.  To reconstruct the state at a delta checkpoint, read the full state file at baseCheckpointTime
+    // and then overwrite elements with the values from each delta file after that time in time order.
     //
     // Returns: true if there is an error, false otherwise.
     //
     // Parameters:
     //
-    // checkpointTime - (s) The value of currentTime at which the values in timePointState were saved.
-    // timePointState - The state to write out to file.
-    static bool writeState(double checkpointTime, const TimePointState& timePointState);
+    // checkpointTime     - (s) The value of currentTime at which the values in timePointState were saved.
+    // timePointState     - The state to write out to file.
+    // baseCheckpointTime - (s) For a delta TimePointState, the value of currentTime of the full checkpoint that the delta applies to.  Ignored for a full TimePointState.
+    static bool writeState(double checkpointTime, const TimePointState& timePointState, double baseCheckpointTime);
     
 private:
     
@@ -182,14 +182,7 @@ bool ForcingManager::readAndSendForcing()
     int    ncErrorCode;      // Return value of NetCDF functions.
     int    fileID;           // ID of NetCDF file.
     bool   fileOpen = false; // Whether fileID refers to an open file.
-    long   year;             // For printing date and time of forcing data.
-    long   month;            // For printing date and time of forcing data.
-    long   day;              // For printing date and time of forcing data.
-    long   hour;             // For printing date and time of forcing data.
-    long   minute;           // For printing date and time of forcing data.
-    double second;           // For printing date and time of forcing data.
-    size_t newIndex;         // Possible new value for jultimeIndex.
-    double newForcingTime;   // (s) Possible new value for nextForcingTime.
+    size_t ii;               // Loop counter.
     
     if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
     {
@@ -202,13 +195,6 @@ bool ForcingManager::readAndSendForcing()
     
     if (!error)
     {
-        // Print out that we are sending the forcing.
-        if (0 == CkMyPe() && 1 <= Readonly::verbosityLevel)
-        {
-            julianToGregorian(jultime[jultimeIndex], &year, &month, &day, &hour, &minute, &second, true);
-            CkPrintf("Reading forcing data for %02ld/%02ld/%04ld %02ld:%02ld:%02.0lf\n", month, day, year, hour, minute, second);
-        }
-        
         // Open the forcing file.
         ncErrorCode = nc_open_par(Readonly::forcingFilePath.c_str(), NC_NETCDF4 | NC_MPIIO, MPI_COMM_WORLD, MPI_INFO_NULL, &fileID);
         
@@ -223,6 +209,51 @@ bool ForcingManager::readAndSendForcing()
         }
     }
     
+    // Opening the file is collective so every ForcingManager has to get here before any of them can go on.  Reading forcingGroupSize instances per open
+    // lets Regions run up to that many forcing intervals ahead of the slowest PE before they need the ForcingManagers to meet again.
+    // Don't read any instance at or after the end of the simulation because no Region will ever use it.
+    for (ii = 0; !error && ii < Readonly::forcingGroupSize && jultimeIndex < jultimeSize && nextForcingTime < simulationEndTime; ++ii)
+    {
+        error = readAndSendForcingInstance(fileID);
+    }
+    
+    // Close the forcing file.
+    if (fileOpen)
+    {
+        ncErrorCode = nc_close(fileID);
+        
+        if (DEBUG_LEVEL & DEBUG_LEVEL_LIBRARY_ERRORS)
+        {
+            if (!(NC_NOERR == ncErrorCode))
+            {
+                CkError("ERROR in ForcingManager::readAndSendForcing: could not close NetCDF forcing file %s.  NetCDF error message: %s.\n", Readonly::forcingFilePath.c_str(), nc_strerror(ncErrorCode));
+                error = true;
+            }
+        }
+    }
+    
+    return error;
+}
+
+bool ForcingManager::readAndSendForcingInstance(int fileID)
+{
+    bool   error = false;  // Error flag.
+    long   year;           // For printing date and time of forcing data.
+    long   month;          // For printing date and time of forcing data.
+    long   day;            // For printing date and time of forcing data.
+    long   hour;           // For printing date and time of forcing data.
+    long   minute;         // For printing date and time of forcing data.
+    double second;         // For printing date and time of forcing data.
+    size_t newIndex;       // Possible new value for jultimeIndex.
+    double newForcingTime; // (s) Possible new value for nextForcingTime.
+    
+    // Print out that we are sending the forcing.
+    if (0 == CkMyPe() && 1 <= Readonly::verbosityLevel)
+    {
+        julianToGregorian(jultime[jultimeIndex], &year, &month, &day, &hour, &minute, &second, true);
+        CkPrintf("Reading forcing data for %02ld/%02ld/%04ld %02ld:%02ld:%02.0lf\n", month, day, year, hour, minute, second);
+    }
+    
     if (!error)
     {
         // Load the forcing.
@@ -350,7 +381,7 @@ bool ForcingManager::readAndSendForcing()
         // Print a warning if we are sending the last forcing time in the file.
         if (0 == CkMyPe() && 2 <= Readonly::verbosityLevel && newIndex == jultimeSize)
         {
-            CkError("WARNING in ForcingManager::readAndSendForcing: reading the last entry in the forcing file.  No more forcing will be loaded in the future for this run.\n");
+            CkError("WARNING in ForcingManager::readAndSendForcingInstance: reading the last entry in the forcing file.  No more forcing will be loaded in the future for this run.\n");
         }
         
         // Send the forcing.
@@ -408,20 +439,5 @@ bool ForcingManager::readAndSendForcing()
         nextForcingTime = newForcingTime;
     }
     
-    // Close the forcing file.
-    if (fileOpen)
-    {
-        ncErrorCode = nc_close(fileID);
-        
-        if (DEBUG_LEVEL & DEBUG_LEVEL_LIBRARY_ERRORS)
-        {
-            if (!(NC_NOERR == ncErrorCode))
-            {
-                CkError("ERROR in ForcingManager::readAndSendForcing: could not close NetCDF forcing file %s.  NetCDF error message: %s.\n", Readonly::forcingFilePath.c_str(), nc_strerror(ncErrorCode));
-                error = true;
-            }
-        }
-    }
-    
     return error;
 }
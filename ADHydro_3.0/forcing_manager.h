@@ -75,12 +75,21 @@ private:
     // Returns: true if there is an error, false otherwise.
     bool readForcingTimes();
     
+    // Open the forcing file and call readAndSendForcingInstance up to Readonly::forcingGroupSize times or until the end of the file or the end of the simulation.
+    //
+    // Returns: true if there is an error, false otherwise.
+    bool readAndSendForcing();
+    
     // Read from the forcing file the instance at jultimeIndex.  Then update jultimeIndex and nextForcingTime to the next instance in the forcing file.
     // When advancing to the next instance protect against jultime being not monotonically increasing and against running off the end of the array.
     // Then send the forcing data and nextForcingTime out to the appropriate elements.
     //
     // Returns: true if there is an error, false otherwise.
-    bool readAndSendForcing();
+    //
+    // Parameters:
+    //
+    // fileID - ID of the open NetCDF forcing file.
+    bool readAndSendForcingInstance(int fileID);
     
     // Returns: (s) the simulation time of jultime[index] or INFINITY if index is off the end of the array.
     //          We round this value to the nearest second because we have had problems with roundoff error setting forcing times to 59.999999... seconds.
@@ -120,14 +120,12 @@ bool groundwaterMeshBoundaryFlowRate(double* flowRate, double* dtNew, BoundaryCo
   return error;
 }
 
-bool groundwaterMeshMeshFlowRate(double* flowRate, double* dtNew, double edgeLength, double elementX, double elementY, double elementZSurface,
+bool groundwaterMeshMeshFlowRate(double* flowRate, double* dtNew, double edgeLength, double distance, double elementZSurface,
                                  double elementZBedrock, double elementArea, double elementConductivity, double elementPorosity,
-                                 double elementGroundwaterHead, double neighborX, double neighborY, double neighborZSurface,
-                                 double neighborZBedrock, double neighborArea, double neighborConductivity, double neighborPorosity, double neighborGroundwaterHead)
+                                 double elementGroundwaterHead, double neighborZSurface, double neighborZBedrock, double neighborArea,
+                                 double neighborConductivity, double neighborPorosity, double neighborGroundwaterHead, double implicitDt)
 {
   bool   error                     = false;                                                 // Error flag.
-  double distance                  = sqrt((elementX - neighborX) * (elementX - neighborX) + // Distance between element and neighbor centers in meters.
-                                          (elementY - neighborY) * (elementY - neighborY));
   double averageArea               = 0.5 * (elementArea + neighborArea);                    // Area to use in calculating dtNew in square meters.
   double averageConductivity       = 0.5 * (elementConductivity + neighborConductivity);    // Conductivity to use in flow calculation in meters per second.
   double averagePorosity           = 0.5 * (elementPorosity + neighborPorosity);            // Porosity to use in calculating dtNew, unitless.
@@ -215,6 +213,12 @@ bool groundwaterMeshMeshFlowRate(double* flowRate, double* dtNew, double edgeLen
       ADHYDRO_ERROR("ERROR in groundwaterMeshMeshFlowRate: neighborPorosity must be greater than zero.\n");
       error = true;
     }
+  
+  if (!(0.0 <= implicitDt))
+    {
+      ADHYDRO_ERROR("ERROR in groundwaterMeshMeshFlowRate: implicitDt must be greater than or equal to zero.\n");
+      error = true;
+    }
 #endif // (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
   
   if (!error)
@@ -243,6 +247,19 @@ bool groundwaterMeshMeshFlowRate(double* flowRate, double* dtNew, double edgeLen
           // Suggest new timestep.
           dtTemp = COURANT_DIFFUSIVE * averagePorosity * 2.0 * averageArea / (averageConductivity * fabs(elementGroundwaterHead - neighborGroundwaterHead));
           
+          if (0.0 < implicitDt)
+            {
+              // Semi-implicit.  Backward Euler for the isolated pair.  averageConductivity * averageHeight * edgeLength / distance is the conductance of the connection.
+              *flowRate /= 1.0 + implicitDt * (averageConductivity * averageHeight * edgeLength / distance) *
+                                 (1.0 / (elementPorosity * elementArea) + 1.0 / (neighborPorosity * neighborArea));
+              
+              // The flow rate is stable for any timestep up to implicitDt so only limit the timestep to implicitDt if the explicit limit is shorter.
+              if (dtTemp < implicitDt)
+                {
+                  dtTemp = implicitDt;
+                }
+            }
+          
           if (*dtNew > dtTemp)
             {
               *dtNew = dtTemp;
@@ -67,8 +67,10 @@ bool groundwaterMeshBoundaryFlowRate(double* flowRate, double* dtNew, BoundaryCo
 //                             suggested value for the next timestep duration
 //                             in seconds.  May be updated to be shorter.
 // edgeLength                - Length of common edge in meters.
-// elementX                  - X coordinate of element center in meters.
-// elementY                  - Y coordinate of element center in meters.
+// distance                  - Distance between element and neighbor centers
+//                             in meters.  This does not change during the
+//                             simulation so the caller is expected to
+//                             calculate it once and save it.
 // elementZSurface           - Surface Z coordinate of element center in
 //                             meters.
 // elementZBedrock           - Bedrock Z coordinate of element center in
@@ -79,8 +81,6 @@ bool groundwaterMeshBoundaryFlowRate(double* flowRate, double* dtNew, BoundaryCo
 // elementPorosity           - Porosity of element, unitless.
 // elementGroundwaterHead    - Groundwater head of element in meters.  If head is at the surface,
 //                             additional head for surfacewater depth must already be added in.
-// neighborX                 - X coordinate of neighbor center in meters.
-// neighborY                 - Y coordinate of neighbor center in meters.
 // neighborZSurface          - Surface Z coordinate of neighbor center in
 //                             meters.
 // neighborZBedrock          - Bedrock Z coordinate of neighbor center in
@@ -91,10 +91,28 @@ bool groundwaterMeshBoundaryFlowRate(double* flowRate, double* dtNew, BoundaryCo
 // neighborPorosity          - Porosity of neighbor, unitless.
 // neighborGroundwaterHead   - Groundwater head of neighbor in meters.  If head is at the surface,
 //                             additional head for surfacewater depth must already be added in.
-bool groundwaterMeshMeshFlowRate(double* flowRate, double* dtNew, double edgeLength, double elementX, double elementY, double elementZSurface,
+// implicitDt                - If zero the flow rate is explicit and dtNew is
+//                             limited by a diffusive Courant condition.  If
+//                             positive the flow rate is semi-implicit for a
+//                             timestep of implicitDt seconds and dtNew is
+//                             limited to the longer of implicitDt and the
+//                             Courant limit so the option never shortens
+//                             timesteps.  See below.
+//
+// The semi-implicit flow rate treats the element and neighbor as an isolated
+// pair of cells with storage porosity times area and integrates the pair with
+// backward Euler over implicitDt.  The explicit flow rate is divided by
+// 1 + implicitDt * C * (1 / (elementPorosity * elementArea) + 1 / (neighborPorosity * neighborArea))
+// where C is the conductance of the connection.  The pair can never overshoot
+// equilibrium no matter how long the timestep, which removes the Courant
+// limit.  The result is symmetric so both ends of the connection calculate the
+// same flow rate and water is conserved.  Flow is underestimated when
+// timesteps are shorter than implicitDt or when neighbors are also exchanging
+// water with other elements.
+bool groundwaterMeshMeshFlowRate(double* flowRate, double* dtNew, double edgeLength, double distance, double elementZSurface,
                                  double elementZBedrock, double elementArea, double elementConductivity, double elementPorosity,
-                                 double elementGroundwaterHead, double neighborX, double neighborY, double neighborZSurface,
-                                 double neighborZBedrock, double neighborArea, double neighborConductivity, double neighborPorosity, double neighborGroundwaterHead);
+                                 double elementGroundwaterHead, double neighborZSurface, double neighborZBedrock, double neighborArea,
+                                 double neighborConductivity, double neighborPorosity, double neighborGroundwaterHead, double implicitDt);
 
 // Calculate the groundwater flow rate in cubic meters per second between a
 // mesh element and a channel element.  Positive means flow out of the mesh
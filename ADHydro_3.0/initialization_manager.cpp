@@ -1078,7 +1078,7 @@ bool InitializationManager::initializeSimulation()
                                           Readonly::globalNumberOfChannelElements, Readonly::localNumberOfChannelElements, Readonly::localChannelElementStart, Readonly::maximumNumberOfChannelNeighbors,
                                           Readonly::globalNumberOfRegions, Readonly::localNumberOfRegions, Readonly::localRegionStart);
         stateData     = new TimePointState(Readonly::globalNumberOfMeshElements, Readonly::localNumberOfMeshElements, Readonly::localMeshElementStart, Readonly::maximumNumberOfMeshNeighbors,
-                                           Readonly::globalNumberOfChannelElements, Readonly::localNumberOfChannelElements, Readonly::localChannelElementStart, Readonly::maximumNumberOfChannelNeighbors);
+                                           Readonly::globalNumberOfChannelElements, Readonly::localNumberOfChannelElements, Readonly::localChannelElementStart, Readonly::maximumNumberOfChannelNeighbors, false);
         
         // FIXME read from file instead.
         error = initializeHardcodedMap(*geometryData, *parameterData, *stateData);
@@ -259,6 +259,30 @@ bool MeshElement::checkInvariant() const
         error = true;
     }
     
+    if (!(0.0 < evapoTranspirationStepDuration))
+    {
+        CkError("ERROR in MeshElement::checkInvariant, element %lu: evapoTranspirationStepDuration must be greater than zero.\n", elementNumber);
+        error = true;
+    }
+    
+    if (!(0.0 >= evapoTranspirationPrecipitation))
+    {
+        CkError("ERROR in MeshElement::checkInvariant, element %lu: evapoTranspirationPrecipitation must be less than or equal to zero.\n", elementNumber);
+        error = true;
+    }
+    
+    if (!(0.0 <= evapoTranspirationSurfacewaterAdd))
+    {
+        CkError("ERROR in MeshElement::checkInvariant, element %lu: evapoTranspirationSurfacewaterAdd must be greater than or equal to zero.\n", elementNumber);
+        error = true;
+    }
+    
+    if (!(0.0 <= evapoTranspirationTranspiration))
+    {
+        CkError("ERROR in MeshElement::checkInvariant, element %lu: evapoTranspirationTranspiration must be greater than or equal to zero.\n", elementNumber);
+        error = true;
+    }
+    
     for (it = neighbors.begin(); it != neighbors.end(); ++it)
     {
         error = it->first.checkInvariant()  || error;
@@ -392,24 +416,16 @@ bool MeshElement::sendNeighborAttributes(std::map<size_t, std::vector<NeighborMe
     return error;
 }
 
-bool MeshElement::sendNeighborInvariant(std::map<size_t, std::vector<InvariantMessage> >& outgoingMessages, size_t& elementsFinished)
+bool MeshElement::sendNeighborInvariant(std::map<size_t, std::vector<InvariantMessage> >& outgoingMessages, double currentTime) const
 {
-    bool                                                  error = false; // Error flag.
-    std::map<NeighborConnection, NeighborProxy>::iterator it;            // Loop iterator.
+    bool                                                        error = false; // Error flag.
+    std::map<NeighborConnection, NeighborProxy>::const_iterator it;            // Loop iterator.
     
     // Don't error check parameters because it's a simple pass-through to NeighborProxy::sendInvariantMessage and it will be checked inside that method.
     
-    neighborsFinished = 0;
-    
     for (it = neighbors.begin(); !error && it != neighbors.end(); ++it)
     {
-        error = it->second.sendInvariantMessage(outgoingMessages, neighborsFinished, it->first);
-    }
-    
-    // Check if this element is finished.
-    if (!error && neighbors.size() == neighborsFinished)
-    {
-        ++elementsFinished;
+        error = it->second.sendInvariantMessage(outgoingMessages, it->first, currentTime);
     }
     
     return error;
@@ -438,33 +454,64 @@ bool MeshElement::calculateNominalFlowRates(std::map<size_t, std::vector<StateMe
     return error;
 }
 
-bool MeshElement::doPointProcessesAndSendOutflows(std::map<size_t, std::vector<WaterMessage> >& outgoingMessages, size_t& elementsFinished, double currentTime, double timestepEndTime)
+bool MeshElement::prepareEvapoTranspirationStep(double currentTime, double timestepEndTime, double evapoTranspirationLimitTime, SolarGeometry& solarGeometry, EvapoTranspirationSoilColumnStruct& column)
+{
+    bool   error = false; // Error flag.
+    double stepStartTime; // (s) Simulation time at the start of the evapotranspiration step.
+    double stepEndTime;   // (s) Simulation time at the end   of the evapotranspiration step.
+    
+    if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
+    {
+        if (!(currentTime < timestepEndTime))
+        {
+            CkError("ERROR in MeshElement::prepareEvapoTranspirationStep: currentTime must be less than timestepEndTime.\n");
+            error = true;
+        }
+        
+        if (!needsEvapoTranspirationStep(timestepEndTime))
+        {
+            CkError("ERROR in MeshElement::prepareEvapoTranspirationStep, element %lu: the current evapotranspiration step covers this timestep.\n", elementNumber);
+            error = true;
+        }
+    }
+    
+    if (!error)
+    {
+        evapoTranspirationStepTimes(currentTime, timestepEndTime, evapoTranspirationLimitTime, stepStartTime, stepEndTime);
+        
+        error = solarGeometry.calculate(Readonly::referenceDate + (stepStartTime / ONE_DAY_IN_SECONDS), longitude, sinLatitude, cosLatitude, column.yearLen, column.julian, column.cosZ);
+    }
+    
+    if (!error)
+    {
+        column.vegType                   = vegetationType;
+        column.soilType                  = groundType;
+        column.lat                       = latitude;
+        column.dt                        = stepEndTime - stepStartTime;
+        column.dx                        = sqrt(elementArea);
+        column.evapoTranspirationForcing = &evapoTranspirationForcing;
+        column.evapoTranspirationState   = &evapoTranspirationState;
+        
+        // Fill in the Noah-MP soil moisture struct from soil and aquifer state.
+        fillInEvapoTranspirationSoilMoistureStruct(column.evapoTranspirationSoilMoisture);
+        
+        // Save the original amount of water stored in evapoTranspirationState for mass balance check.
+        column.originalTotalWaterInDomain = evapoTranspirationTotalWaterInDomain(&evapoTranspirationState);
+    }
+    
+    return error;
+}
+
+bool MeshElement::doPointProcessesAndSendOutflows(std::map<size_t, std::vector<WaterMessage> >& outgoingMessages, size_t& elementsFinished, double currentTime, double timestepEndTime,
+                                                  double evapoTranspirationLimitTime, SolarGeometry& solarGeometry, const EvapoTranspirationSoilColumnStruct* evapoTranspirationColumn)
 {
     bool   error                = false;                                 // Error flag.
-    double localSolarDateTime   = Readonly::referenceDate + (currentTime / ONE_DAY_IN_SECONDS) + (longitude / (2.0 * M_PI)); // (days) Julian date converted from UTC to local solar time.
-    long   year;                                                         // For calculating yearlen, julian, and hourAngle.
-    long   month;                                                        // For calculating hourAngle.
-    long   day;                                                          // For calculating hourAngle.
-    long   hour;                                                         // For passing to julianToGregorian, unused.
-    long   minute;                                                       // For passing to julianToGregorian, unused.
-    double second;                                                       // For passing to julianToGregorian, unused.
-    int    yearlen;                                                      // (days) Year length.
-    float  julian;                                                       // (days) Day of year including fractional day.
-    double hourAngle;                                                    // (radians) How far the sun is east or west of zenith.  Positive means west.  Negative means east.  Used for calculating cosZ.
-    double declinationOfSun;                                             // (radians) How far the sun is above the horizon.  Used for calculating cosZ.
-    float  cosZ;                                                         // Cosine of the angle between the normal to the land surface and the sun.
-    EvapoTranspirationSoilMoistureStruct evapoTranspirationSoilMoisture; // For passing soil moisture profile to Noah-MP.
-    double originalEvapoTranspirationTotalWaterInDomain;                 // (mm) For mass balance check.
     double dt                   = timestepEndTime - currentTime;         // (s) Duration of timestep.
-    float  surfacewaterAdd;                                              // (mm) Water from Noah-MP that must be added to surface water.  Must be non-negative.
-    float  evaporationFromCanopy;                                        // (mm) Water that Noah-MP already added to or removed from the canopy for evaporation or condensation.
-                                                                         // Positive means water evaporated off of the canopy.  Negative means water condensed on to the canopy.
-    float  evaporationFromSnow;                                          // (mm) Water that Noah-MP already added to or removed from the snowpack for evaporation or condensation.
-                                                                         // Positive means water evaporated off of the snowpack.  Negative means water condensed on to the snowpack.
-    float  evaporationFromGround;                                        // (mm) Water that must be added to or removed from the land surface for evaporation or condensation.
-                                                                         // Positive means water evaporated off of the ground.  Negative means water condensed on to the ground.
-    float  transpirationFromVegetation;                                  // (mm) Water that must be removed from the soil moisture for transpiration.  Positive means water transpired off of plants.  Must be non-negative.
-    float  noahMPWaterCreated;                                           // (mm) Water that was created or destroyed by Noah-MP.  Positive means water was created.  Negative means water was destroyed.
+    double evapoTranspirationDt;                                         // (s) Duration of the part of this timestep covered by one evapotranspiration step.
+    double newStepStartTime;                                             // (s) Simulation time at the start of a new evapotranspiration step.
+    double newStepEndTime;                                               // (s) Simulation time at the end   of a new evapotranspiration step.
+    EvapoTranspirationSoilColumnStruct localEvapoTranspirationColumn;    // For running Noah-MP for this element alone if the Region did not pass in a column.
+    double surfacewaterAdd;                                              // (m) Water from Noah-MP that must be added to surface water.  Must be non-negative.
     double precipitation;                                                // (m) Total quantity of water precipitated this timestep.
     double evaporation;                                                  // (m) Total quantity of water evaporated   this timestep.
     double transpiration;                                                // (m) Total quantity of water transpired   this timestep.
@@ -533,83 +580,63 @@ bool MeshElement::doPointProcessesAndSendOutflows(std::map<size_t, std::vector<W
     
     if (!error)
     {
-        // Calculate year, month, and day.  Hour, minute, and second are unused.
-        julianToGregorian(localSolarDateTime, &year, &month, &day, &hour, &minute, &second);
-        
-        // Determine if it is a leap year.
-        if (0 == year % 400)
-        {
-            yearlen = 366;
-        }
-        else if (0 == year % 100)
-        {
-            yearlen = 365;
-        }
-        else if (0 == year % 4)
-        {
-            yearlen = 366;
-        }
-        else
-        {
-            yearlen = 365;
-        }
-        
-        // Calculate the ordinal day of the year by subtracting the Julian date of Jan 1 beginning midnight.
-        julian = localSolarDateTime - gregorianToJulian(year, 1, 1, 0, 0, 0.0);
-        
-        if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
-        {
-            CkAssert(0.0f <= julian && julian < yearlen);
-        }
-        
-        // Calculate cosZ.
-        // FIXME handle slope, aspect, and long distance shading effects on solar radiation by modifying how cosZ is calculated.
-        hourAngle        = (localSolarDateTime - gregorianToJulian(year, month, day, 12, 0, 0.0)) * 2.0 * M_PI;
-        declinationOfSun = -23.44 * (M_PI / 180.0) * cos(2.0 * M_PI * (julian + 10.0) / yearlen);
-        cosZ             = sin(latitude) * sin(declinationOfSun) + cos(latitude) * cos(declinationOfSun) * cos(hourAngle);
-        
-        if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
-        {
-            CkAssert(-1.0f <= cosZ && 1.0f >= cosZ);
-        }
+        // Apply whatever is left of the current evapotranspiration step.  Before the first step evapoTranspirationStepEndTime is negative infinity so nothing is applied.
+        evapoTranspirationDt     = std::max(0.0, std::min(timestepEndTime, evapoTranspirationStepEndTime) - currentTime);
+        precipitation            = evapoTranspirationPrecipitation     * (evapoTranspirationDt / evapoTranspirationStepDuration);
+        surfacewaterAdd          = evapoTranspirationSurfacewaterAdd   * (evapoTranspirationDt / evapoTranspirationStepDuration);
+        evaporation              = evapoTranspirationEvaporation       * (evapoTranspirationDt / evapoTranspirationStepDuration);
+        transpiration            = 0.0;
+        unsatisfiedEvaporation   = evapoTranspirationGroundEvaporation * (evapoTranspirationDt / evapoTranspirationStepDuration);
+        unsatisfiedTranspiration = evapoTranspirationTranspiration     * (evapoTranspirationDt / evapoTranspirationStepDuration);
         
-        // If the sun is below the horizon it doesn't matter how far below.  Set cosZ to zero.
-        if (0.0f > cosZ)
+        // If the current evapotranspiration step ends before this timestep does start a new one.
+        if (needsEvapoTranspirationStep(timestepEndTime))
         {
-            cosZ = 0.0f;
+            evapoTranspirationStepTimes(currentTime, timestepEndTime, evapoTranspirationLimitTime, newStepStartTime, newStepEndTime);
+            
+            // If the Region did not run Noah-MP for this element as part of a batch run it now.
+            if (NULL == evapoTranspirationColumn)
+            {
+                error = prepareEvapoTranspirationStep(currentTime, timestepEndTime, evapoTranspirationLimitTime, solarGeometry, localEvapoTranspirationColumn);
+                
+                if (!error)
+                {
+                    error = evapoTranspirationSoilBatch(1, &localEvapoTranspirationColumn);
+                }
+                
+                evapoTranspirationColumn = &localEvapoTranspirationColumn;
+            }
+            
+            if (!error)
+            {
+                finishEvapoTranspirationStep(newStepStartTime, newStepEndTime, *evapoTranspirationColumn);
+                
+                if (0.0 == Readonly::evapoTranspirationPeriod)
+                {
+                    // The step is exactly this timestep so use the Noah-MP totals directly.  Nothing was applied above because the previous step ended at currentTime.
+                    precipitation            = evapoTranspirationPrecipitation;
+                    surfacewaterAdd          = evapoTranspirationSurfacewaterAdd;
+                    evaporation              = evapoTranspirationEvaporation;
+                    unsatisfiedEvaporation   = evapoTranspirationGroundEvaporation;
+                    unsatisfiedTranspiration = evapoTranspirationTranspiration;
+                }
+                else
+                {
+                    evapoTranspirationDt      = timestepEndTime - newStepStartTime;
+                    precipitation            += evapoTranspirationPrecipitation     * (evapoTranspirationDt / evapoTranspirationStepDuration);
+                    surfacewaterAdd          += evapoTranspirationSurfacewaterAdd   * (evapoTranspirationDt / evapoTranspirationStepDuration);
+                    evaporation              += evapoTranspirationEvaporation       * (evapoTranspirationDt / evapoTranspirationStepDuration);
+                    unsatisfiedEvaporation   += evapoTranspirationGroundEvaporation * (evapoTranspirationDt / evapoTranspirationStepDuration);
+                    unsatisfiedTranspiration += evapoTranspirationTranspiration     * (evapoTranspirationDt / evapoTranspirationStepDuration);
+                }
+            }
         }
-        
-        // Fill in the Noah-MP soil moisture struct from soil and aquifer state.
-        fillInEvapoTranspirationSoilMoistureStruct(evapoTranspirationSoilMoisture);
-        
-        // Save the original amount of water stored in evapoTranspirationState for mass balance check.
-        originalEvapoTranspirationTotalWaterInDomain = evapoTranspirationTotalWaterInDomain(&evapoTranspirationState);
-        
-        // Call Noah-MP.
-        error = evapoTranspirationSoil(vegetationType, groundType, latitude, yearlen, julian, cosZ, dt, sqrt(elementArea), &evapoTranspirationForcing,
-                                       &evapoTranspirationSoilMoisture, &evapoTranspirationState, &surfacewaterAdd, &evaporationFromCanopy, &evaporationFromSnow,
-                                       &evaporationFromGround, &transpirationFromVegetation, &noahMPWaterCreated);
     }
     
     if (!error)
     {
-        // Because Noah-MP uses single precision floats, its roundoff error is much higher than for doubles.  However, we can calculate the mass error using
-        // doubles and account for it in surfaceWaterCreated.  The mass error is the amount of water at the end (water stored in evapoTranspirationState plus water
-        // that came out in the form of surfacewaterAdd, evaporationFromCanopy, and evaporationFromSnow) minus the amount of water at the
-        // beginning (water stored in evapoTranspirationState plus water that went in in the form of precipitation).  evaporationFromGround and
-        // transpirationFromVegetation are not used in this computation because that water was not taken out by Noah-MP.  They are taken below.
-        // evapoTranspirationSoil also tells us if it knowingly created or destroyed any water in noahMPWaterCreated.
-        // However, we don't use that value because this calculation subsumes that quantity at higher precision.
-        surfaceWaterCreated += (((double)evapoTranspirationTotalWaterInDomain(&evapoTranspirationState) + (double)surfacewaterAdd + (double)evaporationFromCanopy + (double)evaporationFromSnow) -
-                                (originalEvapoTranspirationTotalWaterInDomain + evapoTranspirationForcing.prcp * dt)) / 1000.0; // Divide by a thousand to convert from millimeters to meters.
-        
-        // Add surfaceWater and record the quantities of precipitation, evaporation, and transpiration for this timestep.
-        surfaceWater            += surfacewaterAdd / 1000.0;                                               // Divide by a thousand to convert from millimeters to meters.
-        precipitation            = -evapoTranspirationForcing.prcp * dt / 1000.0;                          // Divide by a thousand to convert from millimeters to meters.
-        evaporation              = ((double)evaporationFromCanopy + (double)evaporationFromSnow) / 1000.0; // Divide by a thousand to convert from millimeters to meters.
-        transpiration            = 0.0;
-        unsatisfiedEvaporation   = evaporationFromGround / 1000.0;                                         // Divide by a thousand to convert from millimeters to meters.
-        unsatisfiedTranspiration = transpirationFromVegetation / 1000.0;                                   // Divide by a thousand to convert from millimeters to meters.
+        // Add water from Noah-MP to surfaceWater.
+        surfaceWater += surfacewaterAdd;
         
         // Take evaporation first from surfaceWater, and then if there isn't enough surfaceWater take the rest from subsurface water.
         if (surfaceWater           >= unsatisfiedEvaporation)
@@ -1114,6 +1141,43 @@ void MeshElement::fillInEvapoTranspirationSoilMoistureStruct(EvapoTranspirationS
     evapoTranspirationSoilMoisture.smcwtd = evapoTranspirationSoilMoisture.smc[EVAPO_TRANSPIRATION_NUMBER_OF_SOIL_LAYERS - 1];
 }
 
+void MeshElement::evapoTranspirationStepTimes(double currentTime, double timestepEndTime, double evapoTranspirationLimitTime, double& stepStartTime, double& stepEndTime) const
+{
+    // The new step always covers the rest of this timestep so Noah-MP is called at most once per timestep.
+    // With an evapoTranspirationPeriod of zero every evapotranspiration step is exactly one timestep.
+    stepStartTime = std::max(currentTime, evapoTranspirationStepEndTime);
+    stepEndTime   = std::max(timestepEndTime, std::min(stepStartTime + Readonly::evapoTranspirationPeriod, evapoTranspirationLimitTime));
+}
+
+void MeshElement::finishEvapoTranspirationStep(double stepStartTime, double stepEndTime, const EvapoTranspirationSoilColumnStruct& column)
+{
+    double dt = stepEndTime - stepStartTime; // (s) Duration of evapotranspiration step.
+    
+    if (DEBUG_LEVEL & DEBUG_LEVEL_PRIVATE_FUNCTIONS_SIMPLE)
+    {
+        CkAssert(stepStartTime < stepEndTime && column.evapoTranspirationState == &evapoTranspirationState);
+    }
+    
+    // Because Noah-MP uses single precision floats, its roundoff error is much higher than for doubles.  However, we can calculate the mass error using
+    // doubles and account for it in surfaceWaterCreated.  The mass error is the amount of water at the end (water stored in evapoTranspirationState plus water
+    // that came out in the form of surfacewaterAdd, evaporationFromCanopy, and evaporationFromSnow) minus the amount of water at the
+    // beginning (water stored in evapoTranspirationState plus water that went in in the form of precipitation).  evaporationFromGround and
+    // transpiration are not used in this computation because that water was not taken out by Noah-MP.  They are taken in doPointProcessesAndSendOutflows.
+    // evapoTranspirationSoil also tells us if it knowingly created or destroyed any water in waterError.
+    // However, we don't use that value because this calculation subsumes that quantity at higher precision.
+    surfaceWaterCreated += (((double)evapoTranspirationTotalWaterInDomain(&evapoTranspirationState) + (double)column.surfacewaterAdd + (double)column.evaporationFromCanopy +
+                             (double)column.evaporationFromSnow) - ((double)column.originalTotalWaterInDomain + evapoTranspirationForcing.prcp * dt)) / 1000.0; // Divide by a thousand to convert from millimeters to meters.
+    
+    // Record the totals for the whole step.  doPointProcessesAndSendOutflows applies the fraction of them that falls in each hydrologic timestep.
+    evapoTranspirationStepEndTime       = stepEndTime;
+    evapoTranspirationStepDuration      = dt;
+    evapoTranspirationPrecipitation     = -evapoTranspirationForcing.prcp * dt / 1000.0;                                           // Divide by a thousand to convert from millimeters to meters.
+    evapoTranspirationSurfacewaterAdd   = column.surfacewaterAdd / 1000.0;                                                         // Divide by a thousand to convert from millimeters to meters.
+    evapoTranspirationEvaporation       = ((double)column.evaporationFromCanopy + (double)column.evaporationFromSnow) / 1000.0;    // Divide by a thousand to convert from millimeters to meters.
+    evapoTranspirationGroundEvaporation = column.evaporationFromGround / 1000.0;                                                   // Divide by a thousand to convert from millimeters to meters.
+    evapoTranspirationTranspiration     = column.transpiration / 1000.0;                                                           // Divide by a thousand to convert from millimeters to meters.
+}
+
 void MeshElement::updateHead(double& head, double recharge, double specificYield, double maxHead)
 {
     if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
@@ -2,6 +2,7 @@
 #define __MESH_ELEMENT_H__
 
 #include "checkpoint_manager_data_types.h"
+#include "solar_geometry.h"
 
 // A MeshElement is a triangular element in the mesh.  It simulates overland (non-channel) surfacewater state as well as groundwater and vadose zone state.
 class MeshElement
@@ -16,13 +17,15 @@ public:
                        const SimpleVadoseZone& soilWater = SimpleVadoseZone(), double soilWaterCreated = 0.0, double aquiferHead = 0.0, const SimpleVadoseZone& aquiferWater = SimpleVadoseZone(),
                        double aquiferWaterCreated = 0.0, double deepGroundwater = 0.0, double precipitationCumulative = 0.0, double evaporationCumulative = 0.0, double transpirationCumulative = 0.0,
                        const std::map<NeighborConnection, NeighborProxy>& neighbors = std::map<NeighborConnection, NeighborProxy>()) :
-        elementNumber(elementNumber), catchment(catchment), elementX(elementX), elementY(elementY), elementZ(elementZ), elementArea(elementArea), latitude(latitude), longitude(longitude), slopeX(slopeX),
-        slopeY(slopeY), vegetationType(vegetationType), groundType(groundType), manningsN(manningsN), soilExists(soilExists), impedanceConductivity(impedanceConductivity), aquiferExists(aquiferExists),
+        elementNumber(elementNumber), catchment(catchment), elementX(elementX), elementY(elementY), elementZ(elementZ), elementArea(elementArea), latitude(latitude), longitude(longitude),
+        sinLatitude(sin(latitude)), cosLatitude(cos(latitude)), slopeX(slopeX), slopeY(slopeY), vegetationType(vegetationType), groundType(groundType), manningsN(manningsN), soilExists(soilExists), impedanceConductivity(impedanceConductivity), aquiferExists(aquiferExists),
         deepConductivity(deepConductivity), /* evapoTranspirationForcing and evapoTranspirationState initialized below. */ surfaceWater(surfaceWater), surfaceWaterCreated(surfaceWaterCreated),
         groundwaterMode(groundwaterMode), perchedHead(perchedHead), soilWater(soilWater), soilWaterCreated(soilWaterCreated), soilRecharge(0.0), aquiferHead(aquiferHead), aquiferWater(aquiferWater),
         aquiferWaterCreated(aquiferWaterCreated), aquiferRecharge(0.0), deepGroundwater(deepGroundwater), precipitationRate(0.0), precipitationCumulativeShortTerm(0.0),
         precipitationCumulativeLongTerm(precipitationCumulative), evaporationRate(0.0), evaporationCumulativeShortTerm(0.0), evaporationCumulativeLongTerm(evaporationCumulative),
-        transpirationRate(0.0), transpirationCumulativeShortTerm(0.0), transpirationCumulativeLongTerm(transpirationCumulative), neighbors(neighbors), neighborsFinished(0)
+        transpirationRate(0.0), transpirationCumulativeShortTerm(0.0), transpirationCumulativeLongTerm(transpirationCumulative),
+        evapoTranspirationStepEndTime(-INFINITY), evapoTranspirationStepDuration(1.0), evapoTranspirationPrecipitation(0.0), evapoTranspirationSurfacewaterAdd(0.0),
+        evapoTranspirationEvaporation(0.0), evapoTranspirationGroundEvaporation(0.0), evapoTranspirationTranspiration(0.0), neighbors(neighbors), neighborsFinished(0)
     {
         // Values for evapoTranspirationForcing are going to be received before we start simulating.  For now, just fill in values that will pass the invariant.
         evapoTranspirationForcing.dz8w   = 20.0f;
@@ -120,6 +123,8 @@ public:
         p | elementArea;
         p | latitude;
         p | longitude;
+        p | sinLatitude;
+        p | cosLatitude;
         p | slopeX;
         p | slopeY;
         p | vegetationType;
@@ -152,6 +157,13 @@ public:
         p | transpirationRate;
         p | transpirationCumulativeShortTerm;
         p | transpirationCumulativeLongTerm;
+        p | evapoTranspirationStepEndTime;
+        p | evapoTranspirationStepDuration;
+        p | evapoTranspirationPrecipitation;
+        p | evapoTranspirationSurfacewaterAdd;
+        p | evapoTranspirationEvaporation;
+        p | evapoTranspirationGroundEvaporation;
+        p | evapoTranspirationTranspiration;
         p | neighbors;
         p | neighborsFinished;
     }
@@ -183,15 +195,15 @@ public:
     // elementsFinished - Number of elements in the current Region finished in the initialization phase.  May be incremented if this call causes this element to be finished.
     bool sendNeighborAttributes(std::map<size_t, std::vector<NeighborMessage> >& outgoingMessages, size_t& elementsFinished);
     
-    // Call sendInvariantMessage on all NeighborProxies.
+    // Call sendInvariantMessage on all NeighborProxies.  Must be called before calculateNominalFlowRates in the same timestep.
     //
     // Returns: true if there is an error, false otherwise.
     //
     // Parameters:
     //
     // outgoingMessages - Container to aggregate outgoing messages to other Regions.  Key is Region ID number of message destination.
-    // elementsFinished - Number of elements in the current Region finished in the initialization phase.  May be incremented if this call causes this element to be finished.
-    bool sendNeighborInvariant(std::map<size_t, std::vector<InvariantMessage> >& outgoingMessages, size_t& elementsFinished);
+    // currentTime      - (s) Current simulation time specified as the number of seconds after referenceDate.  Can be negative to specify times before reference date.
+    bool sendNeighborInvariant(std::map<size_t, std::vector<InvariantMessage> >& outgoingMessages, double currentTime) const;
     
     // Call calculateNominalFlowRate on all NeighborProxies.
     //
@@ -218,17 +230,47 @@ public:
         return minimumTime;
     }
     
+    // Returns: Whether doPointProcessesAndSendOutflows will start a new evapotranspiration step in the timestep ending at timestepEndTime.
+    //
+    // Parameters:
+    //
+    // timestepEndTime - (s) Simulation time at the end of the current timestep specified as the number of seconds after referenceDate.  Can be negative to specify times before reference date.
+    inline bool needsEvapoTranspirationStep(double timestepEndTime) const
+    {
+        return evapoTranspirationStepEndTime < timestepEndTime;
+    }
+    
+    // Fill in the Noah-MP inputs for the new evapotranspiration step that doPointProcessesAndSendOutflows will start so that the Region can run Noah-MP for many elements in one batch.
+    // Must only be called if needsEvapoTranspirationStep is true.  Noah-MP state in this element is modified when the batch is run.
+    //
+    // Returns: true if there is an error, false otherwise.
+    //
+    // Parameters:
+    //
+    // currentTime                 - (s) Current simulation time specified as the number of seconds after referenceDate.  Can be negative to specify times before reference date.
+    // timestepEndTime             - (s) Simulation time at the end of the current timestep specified as the number of seconds after referenceDate.  Can be negative to specify times before reference date.
+    // evapoTranspirationLimitTime - (s) See doPointProcessesAndSendOutflows.
+    // solarGeometry               - The Region's solar geometry cache.
+    // column                      - Will be filled in with the inputs for evapoTranspirationSoilBatch.
+    bool prepareEvapoTranspirationStep(double currentTime, double timestepEndTime, double evapoTranspirationLimitTime, SolarGeometry& solarGeometry, EvapoTranspirationSoilColumnStruct& column);
+    
     // Perform precipitation, snowmelt, evaporation, transpiration, infiltration, and send lateral outflows.
     //
     // Returns: true if there is an error, false otherwise.
     //
     // Parameters:
     //
-    // outgoingMessages - Container to aggregate outgoing messages to other Regions.  Key is Region ID number of message destination.
-    // elementsFinished - Number of elements in the current Region finished in the receive water phase.  May be incremented if this call causes this element to be finished.
-    // currentTime      - (s) Current simulation time specified as the number of seconds after referenceDate.  Can be negative to specify times before reference date.
-    // timestepEndTime  - (s) Simulation time at the end of the current timestep specified as the number of seconds after referenceDate.  Can be negative to specify times before reference date.
-    bool doPointProcessesAndSendOutflows(std::map<size_t, std::vector<WaterMessage> >& outgoingMessages, size_t& elementsFinished, double currentTime, double timestepEndTime);
+    // outgoingMessages            - Container to aggregate outgoing messages to other Regions.  Key is Region ID number of message destination.
+    // elementsFinished            - Number of elements in the current Region finished in the receive water phase.  May be incremented if this call causes this element to be finished.
+    // currentTime                 - (s) Current simulation time specified as the number of seconds after referenceDate.  Can be negative to specify times before reference date.
+    // timestepEndTime             - (s) Simulation time at the end of the current timestep specified as the number of seconds after referenceDate.  Can be negative to specify times before reference date.
+    // evapoTranspirationLimitTime - (s) A new evapotranspiration step will not extend past this time unless it has to in order to cover timestepEndTime.
+    //                               This is the Region's next forcing or checkpoint time so that new forcing is used right away and no pending fluxes are left at a checkpoint.
+    // solarGeometry               - The Region's solar geometry cache.  Only used if Noah-MP is run for this element alone.
+    // evapoTranspirationColumn    - If a new evapotranspiration step is needed and this is not NULL it is a column that was filled in by prepareEvapoTranspirationStep with the same times
+    //                               and already run through evapoTranspirationSoilBatch.  If a new step is needed and this is NULL Noah-MP is run for this element alone.
+    bool doPointProcessesAndSendOutflows(std::map<size_t, std::vector<WaterMessage> >& outgoingMessages, size_t& elementsFinished, double currentTime, double timestepEndTime,
+                                         double evapoTranspirationLimitTime, SolarGeometry& solarGeometry, const EvapoTranspirationSoilColumnStruct* evapoTranspirationColumn = NULL);
     
     // Recieve lateral inflows, move water through impedance layer, run aquifer capillary fringe solver, update water table heads, and resolve recharge.
     //
@@ -344,7 +386,7 @@ public:
             
             for (itProxy = neighbors.begin(), itState = state.neighbors.begin(); itProxy != neighbors.end(); ++itProxy, ++itState)
             {
-                if (DEBUG_LEVEL && DEBUG_LEVEL_INTERNAL_SIMPLE)
+                if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
                 {
                     // Because we resized state.neighbors we shouldn't run out of elements in this loop.
                     CkAssert(itState != state.neighbors.end());
@@ -353,7 +395,7 @@ public:
                 itProxy->second.fillInState(*itState, itProxy->first);
             }
             
-            if (DEBUG_LEVEL && DEBUG_LEVEL_INTERNAL_SIMPLE)
+            if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
             {
                 // Because we resized state.neighbors we should hit the end of both containers at the same time.
                 CkAssert(itState == state.neighbors.end());
@@ -369,6 +411,18 @@ public:
         return elementNumber;
     }
     
+    // Returns: the value of vegetationType.
+    inline int getVegetationType() const
+    {
+        return vegetationType;
+    }
+    
+    // Returns: the value of groundType.
+    inline int getGroundType() const
+    {
+        return groundType;
+    }
+    
     // Sets forcing data.
     inline void setEvapoTranspirationForcing(const EvapoTranspirationForcingStruct& newEvapoTranspirationForcing)
     {
@@ -385,6 +439,27 @@ private:
     // evapoTranspirationSoilMoisture - Will be filled in with the soil moisture profile in a format needed by Noah-MP.
     void fillInEvapoTranspirationSoilMoistureStruct(EvapoTranspirationSoilMoistureStruct& evapoTranspirationSoilMoisture);
     
+    // Get the start and end times of the new evapotranspiration step that will be started in the current timestep.
+    //
+    // Parameters:
+    //
+    // currentTime                 - (s) Current simulation time specified as the number of seconds after referenceDate.  Can be negative to specify times before reference date.
+    // timestepEndTime             - (s) Simulation time at the end of the current timestep specified as the number of seconds after referenceDate.  Can be negative to specify times before reference date.
+    // evapoTranspirationLimitTime - (s) See doPointProcessesAndSendOutflows.
+    // stepStartTime               - (s) Scalar passed by reference will be filled in with the simulation time at the start of the evapotranspiration step.
+    // stepEndTime                 - (s) Scalar passed by reference will be filled in with the simulation time at the end   of the evapotranspiration step.
+    void evapoTranspirationStepTimes(double currentTime, double timestepEndTime, double evapoTranspirationLimitTime, double& stepStartTime, double& stepEndTime) const;
+    
+    // Use the results of Noah-MP for one evapotranspiration step and record its fluxes in the evapoTranspiration total variables to be spread evenly over the step.
+    // Noah-MP's roundoff error for the whole step is accounted for in surfaceWaterCreated immediately.
+    //
+    // Parameters:
+    //
+    // stepStartTime - (s) Simulation time at the start of the evapotranspiration step.
+    // stepEndTime   - (s) Simulation time at the end of the evapotranspiration step.  Also sets evapoTranspirationStepEndTime.
+    // column        - A column filled in by prepareEvapoTranspirationStep with the same times and run through evapoTranspirationSoilBatch.
+    void finishEvapoTranspirationStep(double stepStartTime, double stepEndTime, const EvapoTranspirationSoilColumnStruct& column);
+    
     // Update head based on recharge.  If recharge is positive, head is raised.  If recharge is negative, head is lowered.
     // This creates a stable feedback loop that will find a head that produces near zero net recharge after accounting for all flows.
     // At the end, if head is greater than maxHead it is set to maxHead.  This can be used to prevent head from rising above the top of a given layer.
@@ -492,6 +567,8 @@ private:
     double elementArea;           // (m^2) 2D surface area of element ignoring slope.
     double latitude;              // (radians)
     double longitude;             // (radians)
+    double sinLatitude;           // Sine   of latitude.  Precomputed for solar geometry.
+    double cosLatitude;           // Cosine of latitude.  Precomputed for solar geometry.
     double slopeX;                // (m/m) Element slope in X direction.
     double slopeY;                // (m/m) Element slope in Y direction.
     int    vegetationType;        // Type of land cover or land use.
@@ -536,6 +613,16 @@ private:
     double transpirationCumulativeShortTerm; // (m)   Positive means water transpired from the element.  Must be non-negative.
     double transpirationCumulativeLongTerm;  // (m)   Positive means water transpired from the element.  Must be non-negative.
     
+    // Noah-MP is called once per evapotranspiration step, which can span many hydrologic timesteps.  Noah-MP updates evapoTranspirationState for the whole step when it is called.
+    // The fluxes between Noah-MP and the rest of the element are stored as rates and applied across the hydrologic timesteps in the step.
+    double evapoTranspirationStepEndTime;       // (s) Simulation time at the end of the current evapotranspiration step.
+    double evapoTranspirationStepDuration;      // (s) Duration of the current evapotranspiration step.  Must be greater than zero.
+    double evapoTranspirationPrecipitation;     // (m) Precipitation that went into Noah-MP over the whole step.  Negative means water added to the element.  Must be non-positive.
+    double evapoTranspirationSurfacewaterAdd;   // (m) Water from Noah-MP over the whole step that must be added to surface water.  Must be non-negative.
+    double evapoTranspirationEvaporation;       // (m) Evaporation over the whole step that Noah-MP already took from the canopy and snowpack.  Negative means condensation.
+    double evapoTranspirationGroundEvaporation; // (m) Evaporation over the whole step that must be taken from the land surface.  Negative means condensation.
+    double evapoTranspirationTranspiration;     // (m) Transpiration over the whole step that must be taken from the soil moisture.  Must be non-negative.
+    
     // Neighbors of the element.
     std::map<NeighborConnection, NeighborProxy> neighbors;         // A map of NeighborProxies allowing the element to find a specific neighor or iterate over all neighbors.
                                                                    // Keys are NeighborConnection objects that uniquely identify each connection.
@@ -342,6 +342,24 @@ bool NeighborProxy::checkInvariant() const
         error = true;
     }
     
+    if (!(0.0 <= centerDistance))
+    {
+        CkError("ERROR in NeighborProxy::checkInvariant: centerDistance must be greater than or equal to zero.\n");
+        error = true;
+    }
+    
+    if (!(0.0 <= localMidpointDistance))
+    {
+        CkError("ERROR in NeighborProxy::checkInvariant: localMidpointDistance must be greater than or equal to zero.\n");
+        error = true;
+    }
+    
+    if (!(0.0 <= remoteMidpointDistance))
+    {
+        CkError("ERROR in NeighborProxy::checkInvariant: remoteMidpointDistance must be greater than or equal to zero.\n");
+        error = true;
+    }
+    
     if (!(epsilonEqual(1.0, edgeNormalX * edgeNormalX + edgeNormalY * edgeNormalY)))
     {
         CkError("ERROR in NeighborProxy::checkInvariant: edgeNormalX and edgeNormalY must make a unit vector.\n");
@@ -403,7 +421,7 @@ bool NeighborProxy::checkInvariant() const
     return error;
 }
 
-bool NeighborProxy::sendInvariantMessage(std::map<size_t, std::vector<InvariantMessage> >& outgoingMessages, size_t& neighborsFinished, const NeighborConnection& destination)
+bool NeighborProxy::sendInvariantMessage(std::map<size_t, std::vector<InvariantMessage> >& outgoingMessages, const NeighborConnection& destination, double currentTime) const
 {
     bool error = false; // Error flag.
     
@@ -414,12 +432,12 @@ bool NeighborProxy::sendInvariantMessage(std::map<size_t, std::vector<InvariantM
     
     if (!error)
     {
-        if (BOUNDARY_INFLOW == destination.remoteEndpoint || BOUNDARY_OUTFLOW == destination.remoteEndpoint)
-        {
-            // There is no remote neighbor.  Don't send the message and mark the NeighborProxy as finished.
-            ++neighborsFinished;
-        }
-        else
+        // These are the conditions under which calculateNominalFlowRate sends a StateMessage.
+        if (currentTime == expirationTime &&
+            !(BOUNDARY_INFLOW     == destination.remoteEndpoint || BOUNDARY_OUTFLOW     == destination.remoteEndpoint ||
+              TRANSBASIN_INFLOW   == destination.remoteEndpoint || TRANSBASIN_OUTFLOW   == destination.remoteEndpoint ||
+              RESERVOIR_RELEASE   == destination.localEndpoint  || IRRIGATION_DIVERSION == destination.localEndpoint  ||
+              RESERVOIR_RECIPIENT == destination.localEndpoint  || IRRIGATION_RECIPIENT == destination.localEndpoint))
         {
             // Send the message.
             outgoingMessages[neighborRegion].push_back(InvariantMessage(destination, *this));
@@ -429,7 +447,7 @@ bool NeighborProxy::sendInvariantMessage(std::map<size_t, std::vector<InvariantM
     return error;
 }
 
-bool NeighborProxy::checkNeighborInvariant(size_t& neighborsFinished, const NeighborProxy& neighbor, const NeighborAttributes& localAttributes) const
+bool NeighborProxy::checkNeighborInvariant(const NeighborProxy& neighbor, const NeighborAttributes& localAttributes) const
 {
     bool error = false; // Error flag.
     
@@ -486,8 +504,6 @@ bool NeighborProxy::checkNeighborInvariant(size_t& neighborsFinished, const Neig
         CkError("ERROR in NeighborProxy::checkNeighborInvariant: total outflow must be epsilon equal to the negative of neighbor's total inflow.\n");
         error = true;
     }
-   
-    ++neighborsFinished;
     
     return error;
 }
@@ -522,13 +538,16 @@ bool NeighborProxy::sendNeighborMessage(std::map<size_t, std::vector<NeighborMes
     return error;
 }
 
-bool NeighborProxy::receiveNeighborAttributes(size_t& neighborsFinished, const NeighborAttributes& remoteAttributes)
+bool NeighborProxy::receiveNeighborAttributes(size_t& neighborsFinished, const NeighborAttributes& localAttributes, const NeighborAttributes& remoteAttributes)
 {
-    bool error = false; // Error flag.
+    bool   error = false; // Error flag.
+    double midpointX;     // (m) X coordinate of the midpoint between the local and remote element centers.
+    double midpointY;     // (m) Y coordinate of the midpoint between the local and remote element centers.
     
     if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
     {
-        error = remoteAttributes.checkInvariant();
+        error = localAttributes.checkInvariant();
+        error = remoteAttributes.checkInvariant() || error;
         
         if (!(!attributesInitialized))
         {
@@ -541,6 +560,15 @@ bool NeighborProxy::receiveNeighborAttributes(size_t& neighborsFinished, const N
     {
         attributes            = remoteAttributes;
         attributesInitialized = true;
+        centerDistance        = sqrt((localAttributes.elementX - attributes.elementX) * (localAttributes.elementX - attributes.elementX) +
+                                     (localAttributes.elementY - attributes.elementY) * (localAttributes.elementY - attributes.elementY));
+        
+        // Soil or aquifer to surface connections treat the midpoint as the center of the other element.  The distances are calculated from the midpoint instead of
+        // being half of centerDistance so that they are bit for bit identical to calculating them from the midpoint coordinates every time.
+        midpointX              = 0.5 * (localAttributes.elementX + attributes.elementX);
+        midpointY              = 0.5 * (localAttributes.elementY + attributes.elementY);
+        localMidpointDistance  = sqrt((localAttributes.elementX - midpointX) * (localAttributes.elementX - midpointX) + (localAttributes.elementY - midpointY) * (localAttributes.elementY - midpointY));
+        remoteMidpointDistance = sqrt((attributes.elementX - midpointX) * (attributes.elementX - midpointX) + (attributes.elementY - midpointY) * (attributes.elementY - midpointY));
         ++neighborsFinished; // When a NeighborProxy receives attributes it is finished with initialization.
     }
     
@@ -886,33 +914,49 @@ double NeighborProxy::receiveWater(const NeighborConnection& connection, double
 #define INFLOW_VELOCITY (0.0)
 #define INFLOW_HEIGHT   (0.0)
 
+// groundwaterMeshMeshFlowRate treats the surface as a neighbor of the soil or aquifer with the soil porosity so that the explicit Courant condition is unchanged.
+// The semi-implicit flow rate uses porosity as the storage coefficient of each side, and ponded surface water has a storage coefficient of one.
+//
+// Returns: (m^3/m^3) The value to pass as the porosity of the surface side, one if Readonly::groundwaterImplicitDt is positive, otherwise soilPorosity.
+static double surfaceStorageCoefficient(double soilPorosity)
+{
+    return (0.0 < Readonly::groundwaterImplicitDt) ? 1.0 : soilPorosity;
+}
+
 bool NeighborProxy::nominalFlowRateCalculation(NeighborEndpointEnum localEndpoint, NeighborEndpointEnum remoteEndpoint, const NeighborAttributes& localAttributes,
                                                double localDepthOrHead, double remoteDepthOrHead, double currentTime)
 {
     bool   error = false;           // Error flag.
     double dtNew = GLOBAL_DT_LIMIT; // (s) Desired duration until the next expiration time.
+    bool   reuse = (std::abs(localDepthOrHead  - lastLocalDepthOrHead)  <= Readonly::flowRateStateTolerance &&
+                    std::abs(remoteDepthOrHead - lastRemoteDepthOrHead) <= Readonly::flowRateStateTolerance); // If true, keep nominalFlowRate and only extend expirationTime.
     
     if (DEBUG_LEVEL & DEBUG_LEVEL_PRIVATE_FUNCTIONS_SIMPLE)
     {
         CkAssert(!localAttributes.checkInvariant() && currentTime == expirationTime);
     }
     
-    if (MESH_SURFACE == localEndpoint && MESH_SURFACE == remoteEndpoint)
+    if (reuse)
+    {
+        // Neither state has changed enough to matter since the last calculation.  The flow rate calculation only depends on the two states so it would produce the same result,
+        // or nearly the same result if Readonly::flowRateStateTolerance is not zero.
+        dtNew = lastDtNew;
+    }
+    else if (MESH_SURFACE == localEndpoint && MESH_SURFACE == remoteEndpoint)
     {
-        error = surfacewaterMeshMeshFlowRate(&nominalFlowRate, &dtNew, edgeLength, localAttributes.elementX, localAttributes.elementY, localAttributes.elementZTop,
-                                             localAttributes.areaOrLength, localAttributes.manningsN, localDepthOrHead, attributes.elementX, attributes.elementY,
-                                             attributes.elementZTop, attributes.areaOrLength, attributes.manningsN, remoteDepthOrHead);
+        error = surfacewaterMeshMeshFlowRate(&nominalFlowRate, &dtNew, edgeLength, centerDistance, localAttributes.elementZTop, localAttributes.areaOrLength,
+                                             localAttributes.manningsN, localDepthOrHead, attributes.elementZTop, attributes.areaOrLength, attributes.manningsN, remoteDepthOrHead);
     }
     else if ((MESH_SURFACE == localEndpoint && MESH_SOIL    == remoteEndpoint) ||
              (MESH_SURFACE == localEndpoint && MESH_AQUIFER == remoteEndpoint))
     {
-        // Element is the soil neighbor.  Neighbor X and Y are the midpoint between the soil and surface where we assume the soil ends.
+        // Element is the soil neighbor.  Neighbor center is the midpoint between the soil and surface where we assume the soil ends.
         // NeighborZBedrock is the surface elevation.  NeighborZSurface is the surface elevation plus the thickness of the soil layer.
-        // NeighborConductivity and Porosity are the soil values.
-        error = groundwaterMeshMeshFlowRate(&nominalFlowRate, &dtNew, edgeLength, attributes.elementX, attributes.elementY, attributes.elementZTop, attributes.elementZBottom, attributes.areaOrLength,
-                                            attributes.conductivity, attributes.porosityOrBedThickness, remoteDepthOrHead, 0.5 * (localAttributes.elementX + attributes.elementX),
-                                            0.5 * (localAttributes.elementY + attributes.elementY), localAttributes.elementZTop + (attributes.elementZTop - attributes.elementZBottom),
-                                            localAttributes.elementZTop, localAttributes.areaOrLength, attributes.conductivity, attributes.porosityOrBedThickness, localAttributes.elementZTop + localDepthOrHead);
+        // NeighborConductivity and Porosity are the soil values except that the surface storage coefficient is one in semi-implicit mode.  See surfaceStorageCoefficient.
+        error = groundwaterMeshMeshFlowRate(&nominalFlowRate, &dtNew, edgeLength, remoteMidpointDistance, attributes.elementZTop, attributes.elementZBottom, attributes.areaOrLength,
+                                            attributes.conductivity, attributes.porosityOrBedThickness, remoteDepthOrHead, localAttributes.elementZTop + (attributes.elementZTop - attributes.elementZBottom),
+                                            localAttributes.elementZTop, localAttributes.areaOrLength, attributes.conductivity, surfaceStorageCoefficient(attributes.porosityOrBedThickness),
+                                            localAttributes.elementZTop + localDepthOrHead, Readonly::groundwaterImplicitDt);
         
         // Reverse the direction of flow because the local element is neighbor in the previous calculation.
         nominalFlowRate *= -1.0;
@@ -944,20 +988,20 @@ bool NeighborProxy::nominalFlowRateCalculation(NeighborEndpointEnum localEndpoin
     }
     else if (MESH_SOIL == localEndpoint && MESH_SURFACE == remoteEndpoint)
     {
-        // Element is the soil neighbor.  Neighbor X and Y are the midpoint between the soil and surface where we assume the soil ends.
+        // Element is the soil neighbor.  Neighbor center is the midpoint between the soil and surface where we assume the soil ends.
         // NeighborZBedrock is the surface elevation.  NeighborZSurface is the surface elevation plus the thickness of the soil layer.
-        // NeighborConductivity and Porosity are the soil values.
-        error = groundwaterMeshMeshFlowRate(&nominalFlowRate, &dtNew, edgeLength, localAttributes.elementX, localAttributes.elementY, localAttributes.elementZTop, localAttributes.elementZBottom, localAttributes.areaOrLength,
-                                            localAttributes.conductivity, localAttributes.porosityOrBedThickness, localDepthOrHead, 0.5 * (localAttributes.elementX + attributes.elementX),
-                                            0.5 * (localAttributes.elementY + attributes.elementY), attributes.elementZTop + (localAttributes.elementZTop - localAttributes.elementZBottom),
-                                            attributes.elementZTop, attributes.areaOrLength, localAttributes.conductivity, localAttributes.porosityOrBedThickness, attributes.elementZTop + remoteDepthOrHead);
+        // NeighborConductivity and Porosity are the soil values except that the surface storage coefficient is one in semi-implicit mode.  See surfaceStorageCoefficient.
+        error = groundwaterMeshMeshFlowRate(&nominalFlowRate, &dtNew, edgeLength, localMidpointDistance, localAttributes.elementZTop, localAttributes.elementZBottom, localAttributes.areaOrLength,
+                                            localAttributes.conductivity, localAttributes.porosityOrBedThickness, localDepthOrHead, attributes.elementZTop + (localAttributes.elementZTop - localAttributes.elementZBottom),
+                                            attributes.elementZTop, attributes.areaOrLength, localAttributes.conductivity, surfaceStorageCoefficient(localAttributes.porosityOrBedThickness),
+                                            attributes.elementZTop + remoteDepthOrHead, Readonly::groundwaterImplicitDt);
     }
     else if ((MESH_SOIL == localEndpoint && MESH_SOIL    == remoteEndpoint) ||
              (MESH_SOIL == localEndpoint && MESH_AQUIFER == remoteEndpoint))
     {
-        error = groundwaterMeshMeshFlowRate(&nominalFlowRate, &dtNew, edgeLength, localAttributes.elementX, localAttributes.elementY, localAttributes.elementZTop, localAttributes.elementZBottom,
-                                            localAttributes.areaOrLength, localAttributes.conductivity, localAttributes.porosityOrBedThickness, localDepthOrHead, attributes.elementX, attributes.elementY,
-                                            attributes.elementZTop, attributes.elementZBottom, attributes.areaOrLength, attributes.conductivity, attributes.porosityOrBedThickness, remoteDepthOrHead);
+        error = groundwaterMeshMeshFlowRate(&nominalFlowRate, &dtNew, edgeLength, centerDistance, localAttributes.elementZTop, localAttributes.elementZBottom,
+                                            localAttributes.areaOrLength, localAttributes.conductivity, localAttributes.porosityOrBedThickness, localDepthOrHead,
+                                            attributes.elementZTop, attributes.elementZBottom, attributes.areaOrLength, attributes.conductivity, attributes.porosityOrBedThickness, remoteDepthOrHead, Readonly::groundwaterImplicitDt);
     }
     else if (MESH_SOIL == localEndpoint && CHANNEL_SURFACE == remoteEndpoint)
     {
@@ -988,20 +1032,20 @@ bool NeighborProxy::nominalFlowRateCalculation(NeighborEndpointEnum localEndpoin
     }
     else if (MESH_AQUIFER == localEndpoint && MESH_SURFACE == remoteEndpoint)
     {
-        // Element is the soil neighbor.  Neighbor X and Y are the midpoint between the soil and surface where we assume the soil ends.
+        // Element is the soil neighbor.  Neighbor center is the midpoint between the soil and surface where we assume the soil ends.
         // NeighborZBedrock is the surface elevation.  NeighborZSurface is the surface elevation plus the thickness of the soil layer.
-        // NeighborConductivity and Porosity are the soil values.
-        error = groundwaterMeshMeshFlowRate(&nominalFlowRate, &dtNew, edgeLength, localAttributes.elementX, localAttributes.elementY, localAttributes.elementZTop, localAttributes.elementZBottom, localAttributes.areaOrLength,
-                                            localAttributes.conductivity, localAttributes.porosityOrBedThickness, localDepthOrHead, 0.5 * (localAttributes.elementX + attributes.elementX),
-                                            0.5 * (localAttributes.elementY + attributes.elementY), attributes.elementZTop + (localAttributes.elementZTop - localAttributes.elementZBottom),
-                                            attributes.elementZTop, attributes.areaOrLength, localAttributes.conductivity, localAttributes.porosityOrBedThickness, attributes.elementZTop + remoteDepthOrHead);
+        // NeighborConductivity and Porosity are the soil values except that the surface storage coefficient is one in semi-implicit mode.  See surfaceStorageCoefficient.
+        error = groundwaterMeshMeshFlowRate(&nominalFlowRate, &dtNew, edgeLength, localMidpointDistance, localAttributes.elementZTop, localAttributes.elementZBottom, localAttributes.areaOrLength,
+                                            localAttributes.conductivity, localAttributes.porosityOrBedThickness, localDepthOrHead, attributes.elementZTop + (localAttributes.elementZTop - localAttributes.elementZBottom),
+                                            attributes.elementZTop, attributes.areaOrLength, localAttributes.conductivity, surfaceStorageCoefficient(localAttributes.porosityOrBedThickness),
+                                            attributes.elementZTop + remoteDepthOrHead, Readonly::groundwaterImplicitDt);
     }
     else if ((MESH_AQUIFER == localEndpoint && MESH_SOIL == remoteEndpoint) ||
              (MESH_AQUIFER == localEndpoint && MESH_AQUIFER == remoteEndpoint))
     {
-        error = groundwaterMeshMeshFlowRate(&nominalFlowRate, &dtNew, edgeLength, localAttributes.elementX, localAttributes.elementY, localAttributes.elementZTop, localAttributes.elementZBottom,
-                                            localAttributes.areaOrLength, localAttributes.conductivity, localAttributes.porosityOrBedThickness, localDepthOrHead, attributes.elementX, attributes.elementY,
-                                            attributes.elementZTop, attributes.elementZBottom, attributes.areaOrLength, attributes.conductivity, attributes.porosityOrBedThickness, remoteDepthOrHead);
+        error = groundwaterMeshMeshFlowRate(&nominalFlowRate, &dtNew, edgeLength, centerDistance, localAttributes.elementZTop, localAttributes.elementZBottom,
+                                            localAttributes.areaOrLength, localAttributes.conductivity, localAttributes.porosityOrBedThickness, localDepthOrHead,
+                                            attributes.elementZTop, attributes.elementZBottom, attributes.areaOrLength, attributes.conductivity, attributes.porosityOrBedThickness, remoteDepthOrHead, Readonly::groundwaterImplicitDt);
     }
     else if (MESH_AQUIFER == localEndpoint && CHANNEL_SURFACE == remoteEndpoint)
     {
@@ -1051,7 +1095,7 @@ bool NeighborProxy::nominalFlowRateCalculation(NeighborEndpointEnum localEndpoin
     {
         error = surfacewaterChannelChannelFlowRate(&nominalFlowRate, &dtNew, localAttributes.channelType, localAttributes.elementZTop, localAttributes.elementZBottom, localAttributes.areaOrLength,
                                                    localAttributes.slopeXOrBaseWidth, localAttributes.slopeYOrSideSlope, localAttributes.manningsN, localDepthOrHead, attributes.channelType, attributes.elementZTop,
-                                                   attributes.elementZBottom, attributes.areaOrLength, attributes.slopeXOrBaseWidth, attributes.slopeYOrSideSlope, attributes.manningsN, remoteDepthOrHead);
+                                                   attributes.elementZBottom, attributes.areaOrLength, attributes.slopeXOrBaseWidth, attributes.slopeYOrSideSlope, attributes.manningsN, remoteDepthOrHead, Readonly::channelImplicitDt);
     }
     else if (CHANNEL_SURFACE == localEndpoint && BOUNDARY_INFLOW == remoteEndpoint)
     {
@@ -1092,6 +1136,13 @@ bool NeighborProxy::nominalFlowRateCalculation(NeighborEndpointEnum localEndpoin
     
     if (!error)
     {
+        if (!reuse)
+        {
+            lastLocalDepthOrHead  = localDepthOrHead;
+            lastRemoteDepthOrHead = remoteDepthOrHead;
+            lastDtNew             = dtNew;
+        }
+        
         if (INFINITY == dtNew)
         {
             expirationTime = INFINITY;
@@ -1107,7 +1158,7 @@ bool NeighborProxy::nominalFlowRateCalculation(NeighborEndpointEnum localEndpoin
 
 bool NeighborMessage::receive(NeighborProxy& proxy, size_t& neighborsFinished, const NeighborAttributes& localAttributes, double localDepthOrHead, double currentTime, double timestepEndTime) const
 {
-    return proxy.receiveNeighborAttributes(neighborsFinished, attributes);
+    return proxy.receiveNeighborAttributes(neighborsFinished, localAttributes, attributes);
 }
 
 bool StateMessage::receive(NeighborProxy& proxy, size_t& neighborsFinished, const NeighborAttributes& localAttributes, double localDepthOrHead, double currentTime, double timestepEndTime) const
@@ -1122,5 +1173,5 @@ bool WaterMessage::receive(NeighborProxy& proxy, size_t& neighborsFinished, cons
 
 bool InvariantMessage::receive(NeighborProxy& proxy, size_t& neighborsFinished, const NeighborAttributes& localAttributes, double localDepthOrHead, double currentTime, double timestepEndTime) const
 {
-    return proxy.checkNeighborInvariant(neighborsFinished, neighbor, localAttributes);
+    return proxy.checkNeighborInvariant(neighbor, localAttributes);
 }
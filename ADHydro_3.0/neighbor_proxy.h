@@ -278,7 +278,8 @@ public:
     inline NeighborProxy(size_t neighborRegion = 0, double edgeLength = 1.0, double edgeNormalX = 1.0, double edgeNormalY = 0.0, double zOffset = 0.0,
                          double nominalFlowRate = 0.0, double expirationTime = 0.0, double inflowCumulative = 0.0, double outflowCumulative = 0.0) :
         neighborRegion(neighborRegion), edgeLength(edgeLength), edgeNormalX(edgeNormalX), edgeNormalY(edgeNormalY), zOffset(zOffset), attributes(),
-        attributesInitialized(false), nominalFlowRate(nominalFlowRate), expirationTime(expirationTime), inflowCumulativeShortTerm(0.0),
+        attributesInitialized(false), centerDistance(1.0), localMidpointDistance(0.5), remoteMidpointDistance(0.5), nominalFlowRate(nominalFlowRate), expirationTime(expirationTime), lastLocalDepthOrHead(NAN),
+        lastRemoteDepthOrHead(NAN), lastDtNew(NAN), inflowCumulativeShortTerm(0.0),
         inflowCumulativeLongTerm(inflowCumulative), outflowCumulativeShortTerm(0.0), outflowCumulativeLongTerm(outflowCumulative), incomingWater()
     {
         if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
@@ -304,8 +305,14 @@ public:
         p | zOffset;
         p | attributes;
         p | attributesInitialized;
+        p | centerDistance;
+        p | localMidpointDistance;
+        p | remoteMidpointDistance;
         p | nominalFlowRate;
         p | expirationTime;
+        p | lastLocalDepthOrHead;
+        p | lastRemoteDepthOrHead;
+        p | lastDtNew;
         p | inflowCumulativeShortTerm;
         p | inflowCumulativeLongTerm;
         p | outflowCumulativeShortTerm;
@@ -319,16 +326,18 @@ public:
     bool checkInvariant() const;
     
     // Send a message to the remote neighbor with the local values that the remote neighbor needs to check the invariant.
-    // If this is a boundary condition with no remote neighbor no message is sent.
+    // The message is only sent if calculateNominalFlowRate is also going to send a StateMessage to the remote neighbor this timestep so that it can ride along
+    // in the same Charm++ message.  Both NeighborProxies have the same expirationTime so the remote neighbor is waiting for that StateMessage and has not yet
+    // recalculated nominalFlowRate either.  Otherwise no message is sent.
     //
     // Returns: true if there is an error, false otherwise.
     //
     // Parameters:
     //
-    // outgoingMessages  - A container in which to put any message that needs to be sent.  Key is Region ID number of message destination.
-    // neighborsFinished - Number of NeighborProxies in the current element finished in the initialization phase.  May be incremented if this call causes this NeighborProxy to be finished.
-    // destination       - The remote neighbor to send to.
-    bool sendInvariantMessage(std::map<size_t, std::vector<InvariantMessage> >& outgoingMessages, size_t& neighborsFinished, const NeighborConnection& destination);
+    // outgoingMessages - A container in which to put any message that needs to be sent.  Key is Region ID number of message destination.
+    // destination      - The remote neighbor to send to.
+    // currentTime      - (s) Current simulation time specified as the number of seconds after referenceDate.  Can be negative to specify times before reference date.
+    bool sendInvariantMessage(std::map<size_t, std::vector<InvariantMessage> >& outgoingMessages, const NeighborConnection& destination, double currentTime) const;
     
     // Check that the values at this NeighborProxy match the corresponding values at the remote neighbor.
     //
@@ -336,10 +345,9 @@ public:
     //
     // Parameters:
     //
-    // neighborsFinished - Number of NeighborProxies in the current element finished in the invariant check phase.  May be incremented if this call causes this NeighborProxy to be finished.
-    // neighbor          - Values from the remote neighbor to check against local values.
-    // localAttributes   - Values from the local element that are not stored in the NeighborProxy.
-    bool checkNeighborInvariant(size_t& neighborsFinished, const NeighborProxy& neighbor, const NeighborAttributes& localAttributes) const;
+    // neighbor        - Values from the remote neighbor to check against local values.
+    // localAttributes - Values from the local element that are not stored in the NeighborProxy.
+    bool checkNeighborInvariant(const NeighborProxy& neighbor, const NeighborAttributes& localAttributes) const;
     
     // Send a message to the remote neighbor with the immutable attributes of the local element that the remote neighbor needs to calculate nominal flow rates.
     // If this is a boundary condition with no remote neighbor no message is sent and attributesInitialized is marked true.
@@ -354,14 +362,16 @@ public:
     bool sendNeighborMessage(std::map<size_t, std::vector<NeighborMessage> >& outgoingMessages, size_t& neighborsFinished, const NeighborMessage& message);
     
     // Store the received immutable attributes of the remote neighbor and mark attributesInitialized true.
+    // Also calculate values derived from the local and remote attributes that are needed every time nominalFlowRate is calculated.
     //
     // Returns: true if there is an error, false otherwise.
     //
     // Parameters:
     //
     // neighborsFinished - Number of NeighborProxies in the current element finished in the initialization phase.  May be incremented if this call causes this NeighborProxy to be finished.
+    // localAttributes   - Immutable attributes of the local element.
     // remoteAttributes  - The attributes that are being received.
-    bool receiveNeighborAttributes(size_t& neighborsFinished, const NeighborAttributes& remoteAttributes);
+    bool receiveNeighborAttributes(size_t& neighborsFinished, const NeighborAttributes& localAttributes, const NeighborAttributes& remoteAttributes);
     
     // If nominalFlowRate has expired, begin the process of recalculating it.  This may require sending a message to the remote neighbor and waiting for a message in return.
     // In some situations nominalFlowRate can be calculated before leaving this method such as a neighbor in the same Region, or a boundary condition where there is no neighbor.
@@ -495,11 +505,23 @@ private:
     NeighborAttributes attributes;
     bool               attributesInitialized; // If true, attributes have been received from the neighbor.
     
+    // Immutable values derived from the local and remote attributes.  These are calculated once in receiveNeighborAttributes instead of every time nominalFlowRate is calculated.
+    double centerDistance;         // (m) Distance between the local and remote element centers.  Only used for connections between two mesh elements.
+    double localMidpointDistance;  // (m) Distance from the local  element center to the midpoint between the centers.  Only used for soil or aquifer to surface connections.
+    double remoteMidpointDistance; // (m) Distance from the remote element center to the midpoint between the centers.  Only used for soil or aquifer to surface connections.
+    
     // Mutable state of the current flow between the neighbors.
     double nominalFlowRate; // (m^3/s) Positive means flow out of the local element into the remote element.  Negative means flow into the local element out of the remote element.
                             // Actual flow may be less if the sender does not have enough water to satisfy all outflows.
     double expirationTime;  // (s) Simulation time when the neighbors will renegotiate nominalFlowRate specified as the number of seconds after referenceDate.  Can be negative to specify times before reference date.
     
+    // Inputs and outputs of the last time nominalFlowRate was actually calculated.  When nominalFlowRate expires, if neither the local nor the remote state has changed by more than
+    // Readonly::flowRateStateTolerance since then, nominalFlowRate is kept and expirationTime is extended by lastDtNew instead of recalculating.  Both neighbors store the same values
+    // reversed so they always make the same decision.  NAN if nominalFlowRate has not been calculated since this NeighborProxy was created, which forces a calculation.
+    double lastLocalDepthOrHead;  // (m) localDepthOrHead  used in the last calculation.
+    double lastRemoteDepthOrHead; // (m) remoteDepthOrHead used in the last calculation.
+    double lastDtNew;             // (s) Desired duration until the next expiration time from the last calculation.
+    
     // These are variables for recording cumulative flows between the neighbors.  There is some complexity with how they are stored.  Inflows and outflows are stored separately.
     // The purpose of this is to be able to tell the difference between a situation where there has been no flow vs. a situation where flow has gone back and forth with a net flow of zero such as might happen in a tidal basin.
     // In addition, for each direction, flow is stored in two variables, a short term variable and a long term variable.  The purpose of this is to minimize roundoff error.
@@ -776,7 +798,7 @@ public:
     // Parameters:
     //
     // proxy             - The NeighborProxy to pass this message to.
-    // neighborsFinished - Number of NeighborProxies in the current element finished in the invariant check phase.  May be incremented if this call causes proxy to be finished.
+    // neighborsFinished - Unused.  Checking the invariant never finishes a NeighborProxy because InvariantMessages ride along with StateMessages.
     // localAttributes   - Immutable attributes of the local element.
     // localDepthOrHead  - (m) State of the local element.
     // currentTime       - (s) Current simulation time specified as the number of seconds after referenceDate.  Can be negative to specify times before reference date.
@@ -3,23 +3,32 @@
 
 bool Readonly::checkInvariant()
 {
-    bool                     error                           = false;                   // Error flag.
-    const static std::string originalNoahMPMpTableFilePath   = noahMPMpTableFilePath;   // For checking that readonly values are never changed.
-    const static std::string originalNoahMPVegParmFilePath   = noahMPVegParmFilePath;   // For checking that readonly values are never changed.
-    const static std::string originalNoahMPSoilParmFilePath  = noahMPSoilParmFilePath;  // For checking that readonly values are never changed.
-    const static std::string originalNoahMPGenParmFilePath   = noahMPGenParmFilePath;   // For checking that readonly values are never changed.
-    const static std::string originalForcingFilePath         = forcingFilePath;         // For checking that readonly values are never changed.
-    const static double      originalReferenceDate           = referenceDate;           // For checking that readonly values are never changed.
-    const static double      originalSimulationStartTime     = simulationStartTime;     // For checking that readonly values are never changed.
-    const static double      originalSimulationDuration      = simulationDuration;      // For checking that readonly values are never changed.
-    const static double      originalCheckpointPeriod        = checkpointPeriod;        // For checking that readonly values are never changed.
-    const static size_t      originalCheckpointGroupSize     = checkpointGroupSize;     // For checking that readonly values are never changed.
-    const static std::string originalCheckpointDirectoryPath = checkpointDirectoryPath; // For checking that readonly values are never changed.
-    const static bool        originalDrainDownMode           = drainDownMode;           // For checking that readonly values are never changed.
-    const static bool        originalZeroExpirationTime      = zeroExpirationTime;      // For checking that readonly values are never changed.
-    const static bool        originalZeroCumulativeFlow      = zeroCumulativeFlow;      // For checking that readonly values are never changed.
-    const static bool        originalZeroWaterCreated        = zeroWaterCreated;        // For checking that readonly values are never changed.
-    const static size_t      originalVerbosityLevel          = verbosityLevel;          // For checking that readonly values are never changed.
+    bool                     error                            = false;                    // Error flag.
+    const static std::string originalNoahMPMpTableFilePath    = noahMPMpTableFilePath;    // For checking that readonly values are never changed.
+    const static std::string originalNoahMPVegParmFilePath    = noahMPVegParmFilePath;    // For checking that readonly values are never changed.
+    const static std::string originalNoahMPSoilParmFilePath   = noahMPSoilParmFilePath;   // For checking that readonly values are never changed.
+    const static std::string originalNoahMPGenParmFilePath    = noahMPGenParmFilePath;    // For checking that readonly values are never changed.
+    const static std::string originalForcingFilePath          = forcingFilePath;          // For checking that readonly values are never changed.
+    const static size_t      originalForcingGroupSize         = forcingGroupSize;         // For checking that readonly values are never changed.
+    const static double      originalReferenceDate            = referenceDate;            // For checking that readonly values are never changed.
+    const static double      originalSimulationStartTime      = simulationStartTime;      // For checking that readonly values are never changed.
+    const static double      originalSimulationDuration       = simulationDuration;       // For checking that readonly values are never changed.
+    const static double      originalCheckpointPeriod         = checkpointPeriod;         // For checking that readonly values are never changed.
+    const static size_t      originalCheckpointGroupSize      = checkpointGroupSize;      // For checking that readonly values are never changed.
+    const static std::string originalCheckpointDirectoryPath  = checkpointDirectoryPath;  // For checking that readonly values are never changed.
+    const static size_t      originalCheckpointFullInterval   = checkpointFullInterval;   // For checking that readonly values are never changed.
+    const static double      originalCheckpointDeltaThreshold = checkpointDeltaThreshold; // For checking that readonly values are never changed.
+    const static size_t      originalInvariantCheckInterval   = invariantCheckInterval;   // For checking that readonly values are never changed.
+    const static size_t      originalInvariantSampleStride    = invariantSampleStride;    // For checking that readonly values are never changed.
+    const static double      originalEvapoTranspirationPeriod = evapoTranspirationPeriod; // For checking that readonly values are never changed.
+    const static double      originalGroundwaterImplicitDt    = groundwaterImplicitDt;    // For checking that readonly values are never changed.
+    const static double      originalChannelImplicitDt        = channelImplicitDt;        // For checking that readonly values are never changed.
+    const static double      originalFlowRateStateTolerance   = flowRateStateTolerance;   // For checking that readonly values are never changed.
+    const static bool        originalDrainDownMode            = drainDownMode;            // For checking that readonly values are never changed.
+    const static bool        originalZeroExpirationTime       = zeroExpirationTime;       // For checking that readonly values are never changed.
+    const static bool        originalZeroCumulativeFlow       = zeroCumulativeFlow;       // For checking that readonly values are never changed.
+    const static bool        originalZeroWaterCreated         = zeroWaterCreated;         // For checking that readonly values are never changed.
+    const static size_t      originalVerbosityLevel           = verbosityLevel;           // For checking that readonly values are never changed.
     
     if (!(originalNoahMPMpTableFilePath == noahMPMpTableFilePath))
     {
@@ -50,6 +59,18 @@ bool Readonly::checkInvariant()
         ADHYDRO_ERROR("ERROR in Readonly::checkInvariant: forcingFilePath changed, which is not allowed for a readonly variable.\n");
         error = true;
     }
+    
+    if (!(0 < forcingGroupSize))
+    {
+        ADHYDRO_ERROR("ERROR in Readonly::checkInvariant: forcingGroupSize must be greater than zero.\n");
+        error = true;
+    }
+    
+    if (!(originalForcingGroupSize == forcingGroupSize))
+    {
+        ADHYDRO_ERROR("ERROR in Readonly::checkInvariant: forcingGroupSize changed, which is not allowed for a readonly variable.\n");
+        error = true;
+    }
    
     if (!(1721425.5 <= referenceDate))
     {
@@ -117,6 +138,96 @@ bool Readonly::checkInvariant()
         error = true;
     }
     
+    if (!(0 < checkpointFullInterval))
+    {
+        ADHYDRO_ERROR("ERROR in Readonly::checkInvariant: checkpointFullInterval must be greater than zero.\n");
+        error = true;
+    }
+    
+    if (!(originalCheckpointFullInterval == checkpointFullInterval))
+    {
+        ADHYDRO_ERROR("ERROR in Readonly::checkInvariant: checkpointFullInterval changed, which is not allowed for a readonly variable.\n");
+        error = true;
+    }
+    
+    if (!(0.0 <= checkpointDeltaThreshold))
+    {
+        ADHYDRO_ERROR("ERROR in Readonly::checkInvariant: checkpointDeltaThreshold must be greater than or equal to zero.\n");
+        error = true;
+    }
+    
+    if (!(originalCheckpointDeltaThreshold == checkpointDeltaThreshold))
+    {
+        ADHYDRO_ERROR("ERROR in Readonly::checkInvariant: checkpointDeltaThreshold changed, which is not allowed for a readonly variable.\n");
+        error = true;
+    }
+    
+    if (!(originalInvariantCheckInterval == invariantCheckInterval))
+    {
+        ADHYDRO_ERROR("ERROR in Readonly::checkInvariant: invariantCheckInterval changed, which is not allowed for a readonly variable.\n");
+        error = true;
+    }
+    
+    if (!(0 < invariantSampleStride))
+    {
+        ADHYDRO_ERROR("ERROR in Readonly::checkInvariant: invariantSampleStride must be greater than zero.\n");
+        error = true;
+    }
+    
+    if (!(originalInvariantSampleStride == invariantSampleStride))
+    {
+        ADHYDRO_ERROR("ERROR in Readonly::checkInvariant: invariantSampleStride changed, which is not allowed for a readonly variable.\n");
+        error = true;
+    }
+    
+    if (!(0.0 <= evapoTranspirationPeriod))
+    {
+        ADHYDRO_ERROR("ERROR in Readonly::checkInvariant: evapoTranspirationPeriod must be greater than or equal to zero.\n");
+        error = true;
+    }
+    
+    if (!(originalEvapoTranspirationPeriod == evapoTranspirationPeriod))
+    {
+        ADHYDRO_ERROR("ERROR in Readonly::checkInvariant: evapoTranspirationPeriod changed, which is not allowed for a readonly variable.\n");
+        error = true;
+    }
+    
+    if (!(0.0 <= groundwaterImplicitDt))
+    {
+        ADHYDRO_ERROR("ERROR in Readonly::checkInvariant: groundwaterImplicitDt must be greater than or equal to zero.\n");
+        error = true;
+    }
+    
+    if (!(originalGroundwaterImplicitDt == groundwaterImplicitDt))
+    {
+        ADHYDRO_ERROR("ERROR in Readonly::checkInvariant: groundwaterImplicitDt changed, which is not allowed for a readonly variable.\n");
+        error = true;
+    }
+    
+    if (!(0.0 <= channelImplicitDt))
+    {
+        ADHYDRO_ERROR("ERROR in Readonly::checkInvariant: channelImplicitDt must be greater than or equal to zero.\n");
+        error = true;
+    }
+    
+    if (!(originalChannelImplicitDt == channelImplicitDt))
+    {
+        ADHYDRO_ERROR("ERROR in Readonly::checkInvariant: channelImplicitDt changed, which is not allowed for a readonly variable.\n");
+        error = true;
+    }
+    
+    if (!(0.0 <= flowRateStateTolerance))
+    {
+        ADHYDRO_ERROR("ERROR in Readonly::checkInvariant: flowRateStateTolerance must be greater than or equal to zero.\n");
+        error = true;
+    }
+    
+    if (!(originalFlowRateStateTolerance == flowRateStateTolerance))
+    {
+        ADHYDRO_ERROR("ERROR in Readonly::checkInvariant: flowRateStateTolerance changed, which is not allowed for a readonly variable.\n");
+        error = true;
+    }
+    
     if (!(originalDrainDownMode == drainDownMode))
     {
         ADHYDRO_ERROR("ERROR in Readonly::checkInvariant: drainDownMode changed, which is not allowed for a readonly variable.\n");
@@ -372,12 +483,21 @@ std::string Readonly::noahMPVegParmFilePath;
 std::string Readonly::noahMPSoilParmFilePath;
 std::string Readonly::noahMPGenParmFilePath;
 std::string Readonly::forcingFilePath;
+size_t      Readonly::forcingGroupSize;
 double      Readonly::referenceDate;
 double      Readonly::simulationStartTime;
 double      Readonly::simulationDuration;
 double      Readonly::checkpointPeriod;
 size_t      Readonly::checkpointGroupSize;
 std::string Readonly::checkpointDirectoryPath;
+size_t      Readonly::checkpointFullInterval;
+double      Readonly::checkpointDeltaThreshold;
+size_t      Readonly::invariantCheckInterval;
+size_t      Readonly::invariantSampleStride;
+double      Readonly::evapoTranspirationPeriod;
+double      Readonly::groundwaterImplicitDt;
+double      Readonly::channelImplicitDt;
+double      Readonly::flowRateStateTolerance;
 bool        Readonly::drainDownMode;
 bool        Readonly::zeroExpirationTime;
 bool        Readonly::zeroCumulativeFlow;
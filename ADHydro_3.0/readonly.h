@@ -89,34 +89,54 @@ public:
     static size_t getNumberOfCheckpoints();
     
     // Global readonly variables.  For usage see comments in the example superfile.
-    static std::string meshNodeFilePath;        // File from which to read geometry data.
-    static std::string meshZFilePath;           // File from which to read geometry data.
-    static std::string meshElementFilePath;     // File from which to read geometry data.
-    static std::string meshEdgeFilePath;        // File from which to read geometry data.
-    static std::string meshNeighborFilePath;    // File from which to read geometry data.
-    static std::string meshLandFilePath;        // File from which to read parameter data.
-    static std::string meshSoilFilePath;        // File from which to read parameter data.
-    static std::string channelNodeFilePath;     // File from which to read geometry data.
-    static std::string channelZFilePath;        // File from which to read geometry data.
-    static std::string channelElementFilePath;  // File from which to read geometry data.
-    static std::string channelPruneFilePath;    // File from which to read geometry data.
-    static std::string noahMPMpTableFilePath;   // For initializing Noah-MP.
-    static std::string noahMPVegParmFilePath;   // For initializing Noah-MP.
-    static std::string noahMPSoilParmFilePath;  // For initializing Noah-MP.
-    static std::string noahMPGenParmFilePath;   // For initializing Noah-MP.
-    static std::string forcingFilePath;         // File from which to read forcing data.
-    static double      referenceDate;           // (days) Julian date when currentTime is zero.  The current date and time of the simulation is the Julian date equal to referenceDate + (currentTime / ONE_DAY_IN_SECONDS).  Time zone is UTC.
-    static double      simulationStartTime;     // (s) Time when the simulation starts specified as the number of seconds after referenceDate.  Can be negative to specify times before reference date.
-    static double      simulationDuration;      // (s) Time duration that the simulation will run.  Must be positive.  The simulation ends when currentTime is simulationStartTime + simulationDuration.
-    static double      checkpointPeriod;        // (s) Time duration between state checkpoints.  Must be positive.  Checkpoints occur at simulationStartTime + checkpointPeriod, simulationStartTime + 2 * checkpointPeriod, etc.
-                                                // There is always a checkpoint at the end of the simulation even if it is not on a multiple of checkpointPeriod.
-    static size_t      checkpointGroupSize;     // The number of state checkpoints that are accumulated and outputed at the same time.  Increasing this number can reduce time spent on I/O.
-    static std::string checkpointDirectoryPath; // Directory in which to store checkpoint files.
-    static bool        drainDownMode;           // If true, do not allow channels to have more water than bank-full.  Excess water is discarded.
-    static bool        zeroExpirationTime;      // If true, set all nominal flow rates to expired at the beginning of the simulation.
-    static bool        zeroCumulativeFlow;      // If true, set all cumulative flows to zero at the beginning of the simulation.
-    static bool        zeroWaterCreated;        // If true, set all water created to zero at the beginning of the simulation.
-    static size_t      verbosityLevel;          // Controls the amount of messages printed to the console.
+    static std::string meshNodeFilePath;         // File from which to read geometry data.
+    static std::string meshZFilePath;            // File from which to read geometry data.
+    static std::string meshElementFilePath;      // File from which to read geometry data.
+    static std::string meshEdgeFilePath;         // File from which to read geometry data.
+    static std::string meshNeighborFilePath;     // File from which to read geometry data.
+    static std::string meshLandFilePath;         // File from which to read parameter data.
+    static std::string meshSoilFilePath;         // File from which to read parameter data.
+    static std::string channelNodeFilePath;      // File from which to read geometry data.
+    static std::string channelZFilePath;         // File from which to read geometry data.
+    static std::string channelElementFilePath;   // File from which to read geometry data.
+    static std::string channelPruneFilePath;     // File from which to read geometry data.
+    static std::string noahMPMpTableFilePath;    // For initializing Noah-MP.
+    static std::string noahMPVegParmFilePath;    // For initializing Noah-MP.
+    static std::string noahMPSoilParmFilePath;   // For initializing Noah-MP.
+    static std::string noahMPGenParmFilePath;    // For initializing Noah-MP.
+    static std::string forcingFilePath;          // File from which to read forcing data.
+    static size_t      forcingGroupSize;         // The number of forcing data instances that are read and sent at the same time.  Increasing this number reduces how often the
+                                                 // forcing file is opened collectively by all PEs.  The cost is that each Region holds up to forcingGroupSize instances of its forcing, and
+                                                 // while it waits for the current instance it re-sends each future sendForcing message to itself, which uses scheduler CPU time.
+    static double      referenceDate;            // (days) Julian date when currentTime is zero.  The current date and time of the simulation is the Julian date equal to referenceDate + (currentTime / ONE_DAY_IN_SECONDS).  Time zone is UTC.
+    static double      simulationStartTime;      // (s) Time when the simulation starts specified as the number of seconds after referenceDate.  Can be negative to specify times before reference date.
+    static double      simulationDuration;       // (s) Time duration that the simulation will run.  Must be positive.  The simulation ends when currentTime is simulationStartTime + simulationDuration.
+    static double      checkpointPeriod;         // (s) Time duration between state checkpoints.  Must be positive.  Checkpoints occur at simulationStartTime + checkpointPeriod, simulationStartTime + 2 * checkpointPeriod, etc.
+                                                 // There is always a checkpoint at the end of the simulation even if it is not on a multiple of checkpointPeriod.
+    static size_t      checkpointGroupSize;      // The number of state checkpoints that are accumulated and outputed at the same time.  Increasing this number can reduce time spent on I/O.
+    static std::string checkpointDirectoryPath;  // Directory in which to store checkpoint files.
+    static size_t      checkpointFullInterval;   // Every checkpointFullInterval'th checkpoint is a full checkpoint.  Checkpoints in between are delta checkpoints that only contain elements whose state changed
+                                                 // since the previous checkpoint.  The last checkpoint of the simulation is always full.  One means every checkpoint is full.
+    static double      checkpointDeltaThreshold; // For delta checkpoints, an element is considered changed if any real valued state variable changed by more than this absolute amount.
+                                                 // Opaque state blobs and integer state variables are considered changed if they differ at all.  Zero means any change at all is written.
+    static size_t      invariantCheckInterval;   // The invariant is checked at every invariantCheckInterval'th sync time, when all Regions stop to receive forcing or write a checkpoint.  Zero means never.
+                                                 // This is selected at run time independent of DEBUG_LEVEL so that release builds can still do light validation on field runs.
+    static size_t      invariantSampleStride;    // Each time the invariant is checked, one out of every invariantSampleStride elements is checked.  The subset rotates so that every element
+                                                 // is checked once in every invariantSampleStride checks.  One means every element is checked every time.
+    static double      evapoTranspirationPeriod; // (s) Time duration between calls to Noah-MP.  Evapotranspiration fluxes are applied as rates across the hydrologic timesteps in between.
+                                                 // Noah-MP steps never cross a forcing or checkpoint time.  Zero means call Noah-MP every hydrologic timestep and apply its
+                                                 // totals directly, which is bit for bit identical to versions before this option existed.
+    static double      groundwaterImplicitDt;    // (s) If positive, groundwater flow rates between mesh elements are semi-implicit for timesteps up to this long instead of being
+                                                 // limited by a Courant condition.  See groundwaterMeshMeshFlowRate.  Zero means explicit flow rates.
+    static double      channelImplicitDt;        // (s) If positive, flow rates between stream elements are implicit for timesteps up to this long instead of being
+                                                 // limited by a Courant condition.  See surfacewaterChannelChannelFlowRate.  Zero means explicit flow rates.
+    static double      flowRateStateTolerance;   // (m) When a nominal flow rate expires it is reused instead of recalculated if neither neighbor's depth or head has changed by more than
+                                                 // this since it was last calculated.  Zero means only reuse flow rates when neither state has changed at all.
+    static bool        drainDownMode;            // If true, do not allow channels to have more water than bank-full.  Excess water is discarded.
+    static bool        zeroExpirationTime;       // If true, set all nominal flow rates to expired at the beginning of the simulation.
+    static bool        zeroCumulativeFlow;       // If true, set all cumulative flows to zero at the beginning of the simulation.
+    static bool        zeroWaterCreated;         // If true, set all water created to zero at the beginning of the simulation.
+    static size_t      verbosityLevel;           // Controls the amount of messages printed to the console.
     
     // Variables for number of items.
     // FIXME Once we implement mesh adaption, these variables won't be read-only.
@@ -8,9 +8,27 @@
 
 bool Region::checkInvariant() const
 {
-    bool                                             error = false; // Error flag.
-    std::map<size_t,    MeshElement>::const_iterator itMesh;        // Loop iterator.
-    std::map<size_t, ChannelElement>::const_iterator itChannel;     // Loop iterator.
+    bool error; // Error flag.
+    
+    error = checkRegionInvariant();
+    error = checkElementsInvariant(false) || error;
+    
+    return error;
+}
+
+bool Region::checkSampledInvariant() const
+{
+    bool error; // Error flag.
+    
+    error = checkRegionInvariant();
+    error = checkElementsInvariant(true) || error;
+    
+    return error;
+}
+
+bool Region::checkRegionInvariant() const
+{
+    bool error = false; // Error flag.
     
     if (!(currentTime <= timestepEndTime && timestepEndTime <= nextForcingTime && timestepEndTime <= Readonly::getCheckpointTime(nextCheckpointIndex)))
     {
@@ -18,32 +36,47 @@ bool Region::checkInvariant() const
         error = true;
     }
     
+    if (!(meshElements.size() + channelElements.size() >= elementsFinished))
+    {
+        CkError("ERROR in Region::checkInvariant, region %lu: elementsFinished must be less than or equal to meshElements.size() plus channelElements.size().\n", thisIndex);
+        error = true;
+    }
+    
+    return error;
+}
+
+bool Region::checkElementsInvariant(bool sampledOnly) const
+{
+    bool                                             error = false; // Error flag.
+    std::map<size_t,    MeshElement>::const_iterator itMesh;        // Loop iterator.
+    std::map<size_t, ChannelElement>::const_iterator itChannel;     // Loop iterator.
+    
     for (itMesh = meshElements.begin(); itMesh != meshElements.end(); ++itMesh)
     {
-        if (!(itMesh->second.getElementNumber() == itMesh->first))
+        if (!sampledOnly || invariantSampled(itMesh->first))
         {
-            CkError("ERROR in Region::checkInvariant, region %lu: mesh element %lu stored at map key %lu.\n", thisIndex, itMesh->second.getElementNumber(), itMesh->first);
-            error = true;
+            if (!(itMesh->second.getElementNumber() == itMesh->first))
+            {
+                CkError("ERROR in Region::checkInvariant, region %lu: mesh element %lu stored at map key %lu.\n", thisIndex, itMesh->second.getElementNumber(), itMesh->first);
+                error = true;
+            }
+            
+            error = itMesh->second.checkInvariant() || error;
         }
-        
-        error = itMesh->second.checkInvariant() || error;
     }
     
     for (itChannel = channelElements.begin(); itChannel != channelElements.end(); ++itChannel)
     {
-        if (!(itChannel->second.getElementNumber() == itChannel->first))
+        if (!sampledOnly || invariantSampled(itChannel->first))
         {
-            CkError("ERROR in Region::checkInvariant, region %lu: channel element %lu stored at map key %lu.\n", thisIndex, itChannel->second.getElementNumber(), itChannel->first);
-            error = true;
+            if (!(itChannel->second.getElementNumber() == itChannel->first))
+            {
+                CkError("ERROR in Region::checkInvariant, region %lu: channel element %lu stored at map key %lu.\n", thisIndex, itChannel->second.getElementNumber(), itChannel->first);
+                error = true;
+            }
+            
+            error = itChannel->second.checkInvariant() || error;
         }
-        
-        error = itChannel->second.checkInvariant() || error;
-    }
-    
-    if (!(meshElements.size() + channelElements.size() >= elementsFinished))
-    {
-        CkError("ERROR in Region::checkInvariant, region %lu: elementsFinished must be less than or equal to meshElements.size() plus channelElements.size().\n", thisIndex);
-        error = true;
     }
     
     return error;
@@ -111,3 +144,130 @@ void Region::receiveMessage(Message& message)
             break;
     }
 }
+
+void Region::sendCheckpointState()
+{
+    std::map<size_t,                                                    MeshElement>::iterator itMesh;       // Loop iterator.
+    std::map<size_t,                                                 ChannelElement>::iterator itChannel;    // Loop iterator.
+    std::map<size_t, std::pair<std::vector<MeshState>, std::vector<ChannelState> > >::iterator itState;      // Loop iterator.
+    std::map<size_t, size_t>                                                                   meshCount;    // Number of mesh    elements going to each destination PE.
+    std::map<size_t, size_t>                                                                   channelCount; // Number of channel elements going to each destination PE.
+    std::map<size_t, size_t>::iterator                                                         itCount;      // Loop iterator.
+    size_t                                                                                     ii;           // Loop counter.
+    
+    // Elements never move between Regions after initialization so the destination of each element only needs to be calculated once.
+    if (!outgoingStateSized)
+    {
+        for (itMesh = meshElements.begin(); itMesh != meshElements.end(); ++itMesh)
+        {
+            ++meshCount[Readonly::home(itMesh->first, Readonly::globalNumberOfMeshElements, CkNumPes())];
+        }
+        
+        for (itChannel = channelElements.begin(); itChannel != channelElements.end(); ++itChannel)
+        {
+            ++channelCount[Readonly::home(itChannel->first, Readonly::globalNumberOfChannelElements, CkNumPes())];
+        }
+        
+        outgoingState.clear();
+        
+        for (itCount = meshCount.begin(); itCount != meshCount.end(); ++itCount)
+        {
+            outgoingState[itCount->first].first.resize(itCount->second);
+        }
+        
+        for (itCount = channelCount.begin(); itCount != channelCount.end(); ++itCount)
+        {
+            outgoingState[itCount->first].second.resize(itCount->second);
+        }
+        
+        outgoingStateSized = true;
+    }
+    
+    // Fill in each destination's vectors from the next contiguous run of elements.
+    itMesh    = meshElements.begin();
+    itChannel = channelElements.begin();
+    
+    for (itState = outgoingState.begin(); itState != outgoingState.end(); ++itState)
+    {
+        for (ii = 0; ii < itState->second.first.size(); ++ii, ++itMesh)
+        {
+            if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
+            {
+                // Because elements are iterated in element number order this element should go to the current destination.
+                CkAssert(itMesh != meshElements.end() && Readonly::home(itMesh->first, Readonly::globalNumberOfMeshElements, CkNumPes()) == itState->first);
+            }
+            
+            if (itMesh->second.fillInState(itState->second.first[ii]))
+            {
+                CkExit();
+            }
+        }
+        
+        for (ii = 0; ii < itState->second.second.size(); ++ii, ++itChannel)
+        {
+            if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
+            {
+                // Because elements are iterated in element number order this element should go to the current destination.
+                CkAssert(itChannel != channelElements.end() && Readonly::home(itChannel->first, Readonly::globalNumberOfChannelElements, CkNumPes()) == itState->first);
+            }
+            
+            if (itChannel->second.fillInState(itState->second.second[ii]))
+            {
+                CkExit();
+            }
+        }
+        
+        ADHydro::checkpointManagerProxy[itState->first].sendState(nextCheckpointIndex, itState->second.first, itState->second.second);
+    }
+}
+
+// Returns: true if element1 comes before element2 in meshElementsByParameters, false otherwise.
+static bool meshElementParametersLess(const MeshElement* element1, const MeshElement* element2)
+{
+    return (element1->getVegetationType() < element2->getVegetationType() ||
+            (element1->getVegetationType() == element2->getVegetationType() && element1->getGroundType() < element2->getGroundType()));
+}
+
+// Returns: true if element1 comes before element2 in channelElementsByParameters, false otherwise.
+static bool channelElementParametersLess(const ChannelElement* element1, const ChannelElement* element2)
+{
+    return (element1->getChannelType() < element2->getChannelType());
+}
+
+void Region::sortElementsByParameters()
+{
+    std::map<size_t,    MeshElement>::iterator itMesh;    // Loop iterator.
+    std::map<size_t, ChannelElement>::iterator itChannel; // Loop iterator.
+    size_t                                     ii;        // Loop counter.
+    
+    meshElementsByParameters.clear();
+    channelElementsByParameters.clear();
+    
+    // Pointers to map values stay valid as long as the elements are not erased, and elements are never erased after initialization.
+    for (itMesh = meshElements.begin(); itMesh != meshElements.end(); ++itMesh)
+    {
+        meshElementsByParameters.push_back(&itMesh->second);
+    }
+    
+    for (itChannel = channelElements.begin(); itChannel != channelElements.end(); ++itChannel)
+    {
+        channelElementsByParameters.push_back(&itChannel->second);
+    }
+    
+    // Stable sort keeps elements with the same parameters in element number order.
+    std::stable_sort(meshElementsByParameters.begin(),    meshElementsByParameters.end(),    meshElementParametersLess);
+    std::stable_sort(channelElementsByParameters.begin(), channelElementsByParameters.end(), channelElementParametersLess);
+    
+    meshElementsExpirationTime.resize(meshElementsByParameters.size());
+    channelElementsExpirationTime.resize(channelElementsByParameters.size());
+    
+    for (ii = 0; ii < meshElementsByParameters.size(); ++ii)
+    {
+        meshElementsExpirationTime[ii] = meshElementsByParameters[ii]->minimumExpirationTime();
+    }
+    
+    for (ii = 0; ii < channelElementsByParameters.size(); ++ii)
+    {
+        channelElementsExpirationTime[ii] = channelElementsByParameters[ii]->minimumExpirationTime();
+    }
+}
@@ -6,6 +6,12 @@
 #include "readonly.h"
 #include "region.decl.h"
 
+// If true the Region runs Noah-MP for all of its mesh elements that start an evapotranspiration step in a timestep with one call to evapoTranspirationSoilBatch.
+// If false each MeshElement runs Noah-MP for itself.  The results are the same either way.
+#ifndef BATCH_EVAPO_TRANSPIRATION
+#define BATCH_EVAPO_TRANSPIRATION (true)
+#endif // BATCH_EVAPO_TRANSPIRATION
+
 // A Region is a Charm++ chare object that holds multiple mesh and channel elements and implements some of our basic simulation architecture.
 // The architecture is an explicit first-order simulation of moving water between various containers such as: groundwater, surfacewater, streams, lakes, etc.
 // Each pair of neighboring containers calculate a simple linear flow rate, cubic meters per second, and an expiration time for how long this flow rate is valid.
@@ -46,7 +52,10 @@ public:
     //
     // msg - Unused migration message.
     inline Region(CkMigrateMessage* msg = NULL) : currentTime(Readonly::simulationStartTime), timestepEndTime(Readonly::simulationStartTime), nextForcingTime(Readonly::simulationStartTime),
-                                                  nextCheckpointIndex(1), numberOfMeshElements(0), numberOfChannelElements(0), meshElements(), channelElements(), elementsFinished(0)
+                                                  nextCheckpointIndex(1), syncCount(0), invariantCheckCount(0), checkingInvariant(false), numberOfMeshElements(0), numberOfChannelElements(0), meshElements(), channelElements(), elementsFinished(0),
+                                                  outgoingStateSized(false), outgoingState(), meshElementsByParameters(), channelElementsByParameters(),
+                                                  meshElementsExpirationTime(), channelElementsExpirationTime(), activeMeshElements(), activeChannelElements(),
+                                                  meshEvapoTranspirationColumns(), solarGeometry()
     {
         if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
         {
@@ -73,6 +82,9 @@ public:
         p | timestepEndTime;
         p | nextForcingTime;
         p | nextCheckpointIndex;
+        p | syncCount;
+        p | invariantCheckCount;
+        p | checkingInvariant;
         p | numberOfMeshElements;
         p | numberOfChannelElements;
         p | meshElements;
@@ -85,6 +97,12 @@ public:
     // Returns: true if the invariant is violated, false otherwise.
     bool checkInvariant() const;
     
+    // Check invariant conditions on data that belongs to the Region itself and on the elements in the subset sampled for the current invariant check.
+    // If Readonly::invariantSampleStride is one this is the same as checkInvariant.
+    //
+    // Returns: true if the invariant is violated, false otherwise.
+    bool checkSampledInvariant() const;
+    
     // Loop over a vector of Messages calling receiveMessage on each one.  Exit on error.
     // This function is necessary because you can't pass a std::vector<SubClass> as a reference to std::vector<SuperClass>
     // the same way you can pass an individual SubClass as a reference to SuperClass.
@@ -110,14 +128,46 @@ public:
     // message - The received message.
     void receiveMessage(Message& message);
     
+    // Send the state of every element to the CheckpointManagers for checkpoint nextCheckpointIndex.  Exit on error.
+    // The first call sizes outgoingState with the exact number of elements going to each CheckpointManager.  Later calls reuse it.
+    void sendCheckpointState();
+    
 private:
     
+    // Fill in meshElementsByParameters and channelElementsByParameters with all of the elements in this Region.
+    // Also fill in meshElementsExpirationTime and channelElementsExpirationTime to match.
+    void sortElementsByParameters();
+    
     // Returns: (s) The next time when all regions have to stop at a synchronized simulation time to receive forcing or write state.
     inline double nextSyncTime()
     {
         return std::min(nextForcingTime, Readonly::getCheckpointTime(nextCheckpointIndex));
     }
     
+    // Check invariant conditions on data that belongs to the Region itself rather than to any of its elements.
+    //
+    // Returns: true if the invariant is violated, false otherwise.
+    bool checkRegionInvariant() const;
+    
+    // Check invariant conditions on the elements in the Region.
+    //
+    // Returns: true if the invariant is violated, false otherwise.
+    //
+    // Parameters:
+    //
+    // sampledOnly - If true only check the elements for which invariantSampled is true.  Otherwise check all elements.
+    bool checkElementsInvariant(bool sampledOnly) const;
+    
+    // Returns: Whether the element with the given element number is in the subset of elements sampled for the current invariant check.
+    //
+    // Parameters:
+    //
+    // elementNumber - The element number of a MeshElement or ChannelElement.
+    inline bool invariantSampled(size_t elementNumber) const
+    {
+        return 0 == (elementNumber + invariantCheckCount) % Readonly::invariantSampleStride;
+    }
+    
     // Simulation time.
     double       currentTime;         // (s) Current simulation time specified as the number of seconds after referenceDate.  Can be negative to specify times before reference date.
     double       timestepEndTime;     // (s) Simulation time at the end of the current timestep specified as the number of seconds after referenceDate.  Can be negative to specify times before reference date.
@@ -126,6 +176,11 @@ private:
     const double simulationEndTime = Readonly::simulationStartTime + Readonly::simulationDuration;
                                       // This is partly for efficiency so we don't do the addition over and over and partly because Charm++ is having trouble parsing Readonly:: in the .ci file.
     
+    // Invariant checking.  See Readonly::invariantCheckInterval and Readonly::invariantSampleStride.
+    size_t syncCount;           // The number of sync times this Region has passed.
+    size_t invariantCheckCount; // The number of times this Region has checked the invariant.  Used to rotate the sampled subset of elements.
+    bool   checkingInvariant;   // Whether the invariant is being checked this timestep.
+    
     // Elements in the Region.
     size_t                           numberOfMeshElements;    // For initialization, the Region will wait until it receives this many MeshElements.
     size_t                           numberOfChannelElements; // For initialization, the Region will wait until it receives this many ChannelElements.
@@ -133,6 +188,32 @@ private:
     std::map<size_t, ChannelElement> channelElements;         // A map of channelElements allowing the Region to find a specific element or iterate over all elements.  Keys are element ID numbers.
     size_t                           elementsFinished;        // Number of elements finished in the current phase such as initialization, invariant check, receive state, or receive water.
                                                               // This Region is finished when elementsFinished equals meshElements.size() plus channelElements.size().
+    
+    // Checkpoint state.  These are not pupped.  They are rebuilt after migration the first time a checkpoint is sent.
+    bool                                                                             outgoingStateSized; // Whether outgoingState has been sized for the elements in this Region.
+    std::map<size_t, std::pair<std::vector<MeshState>, std::vector<ChannelState> > > outgoingState;      // State going to various CheckpointManagers.  Key is the destination PE.
+                                                                                                         // Readonly::home is nondecreasing in element number and meshElements and channelElements are
+                                                                                                         // iterated in element number order so each destination gets a contiguous run of each map.
+    
+    // Point process order.  These are not pupped.  They are rebuilt after migration the first time nominal flow rates are calculated.
+    // Noah-MP parameters are set from vegetation and soil type so processing elements of the same type consecutively lets evapo-transpiration skip setting them.
+    std::vector<MeshElement*>    meshElementsByParameters;    // Pointers to the MeshElements    in meshElements    sorted by vegetationType and then groundType.
+    std::vector<ChannelElement*> channelElementsByParameters; // Pointers to the ChannelElements in channelElements sorted by channelType.
+    
+    // Active set.  These are not pupped.  They are rebuilt along with meshElementsByParameters and channelElementsByParameters.
+    // A NeighborProxy's nominal flow rate only changes when it expires so an element with no expired NeighborProxies can skip the nominal flow rate phase without looping over its
+    // neighbors, and the Region only needs to find the new minimum expiration time of elements that were active.
+    std::vector<double> meshElementsExpirationTime;    // (s) Cached minimumExpirationTime of each element in meshElementsByParameters.
+    std::vector<double> channelElementsExpirationTime; // (s) Cached minimumExpirationTime of each element in channelElementsByParameters.
+    std::vector<size_t> activeMeshElements;            // Indices into meshElementsByParameters    of elements that had expired NeighborProxies in the current timestep.
+    std::vector<size_t> activeChannelElements;         // Indices into channelElementsByParameters of elements that had expired NeighborProxies in the current timestep.
+    
+    // Noah-MP inputs and outputs for the mesh elements that start an evapotranspiration step in the current timestep, in the order of meshElementsByParameters.  Only used if
+    // BATCH_EVAPO_TRANSPIRATION is true.  Not pupped.  It is refilled every timestep and kept as a member so that its memory is reused.
+    std::vector<EvapoTranspirationSoilColumnStruct> meshEvapoTranspirationColumns;
+    
+    // Solar geometry shared by all elements in the Region.  Not pupped.  It is a cache that refills itself when needed.
+    SolarGeometry solarGeometry;
 };
 
 #endif // __REGION_H__
@@ -33,6 +33,11 @@ bool SimpleVadoseZone::checkInvariant() const
         ADHYDRO_ERROR("ERROR in SimpleGroundwater::checkInvariant: water must be greater than or equal to zero and less than or equal to porosity * thickness.\n");
         error = true;
     }
+    else if (!(saturationDepthFromWater(water) == saturationDepth))
+    {
+        ADHYDRO_ERROR("ERROR in SimpleGroundwater::checkInvariant: saturationDepth must be consistent with water.\n");
+        error = true;
+    }
     
     return error;
 }
@@ -84,20 +89,20 @@ bool SimpleVadoseZone::doTimestep(double& groundwaterRecharge, double& surfaceWa
         if (water > equilibriumWater && water - equilibriumWater > conductivity * dt - newRecharge)
         {
                 // Water movement is limited by conductivity.
-                water       -= conductivity * dt - newRecharge;
-                newRecharge  = conductivity * dt;
+                setWater(water - (conductivity * dt - newRecharge));
+                newRecharge = conductivity * dt;
         }
         else if (water < equilibriumWater && equilibriumWater - water > conductivity * dt + newRecharge)
         {
                 // Water movement is limited by conductivity.
-                water       +=  conductivity * dt + newRecharge;
-                newRecharge  = -conductivity * dt;
+                setWater(water + (conductivity * dt + newRecharge));
+                newRecharge = -conductivity * dt;
         }
         else
         {
                 // Water will reach equilibrium.
                 newRecharge -= equilibriumWater - water;
-                water        = equilibriumWater;
+                setWater(equilibriumWater);
         }
         
         groundwaterRecharge += newRecharge;
@@ -113,14 +118,14 @@ void SimpleVadoseZone::addOrRemoveWater(double& recharge, double& waterCreated)
         if (water + recharge <= porosity * thickness)
         {
             // All of the water will fit.
-            water   += recharge;
+            setWater(water + recharge);
             recharge = 0.0;
         }
         else
         {
             // Not all of the water will fit.
             recharge = (water + recharge) - (porosity * thickness); // Grouping is designed to prevent recharge from going negative due to roundoff error.
-            water    = porosity * thickness;
+            setWater(porosity * thickness);
         }
     }
     else if (0.0 > recharge)
@@ -128,14 +133,14 @@ void SimpleVadoseZone::addOrRemoveWater(double& recharge, double& waterCreated)
         if (water + recharge >= 0.0)
         {
             // There is enough water to cover recharge.
-            water   += recharge;
+            setWater(water + recharge);
             recharge = 0.0;
         }
         else
         {
             // There is not enough water to cover recharge.
             waterCreated -= water + recharge; // Subtract a negative water deficit to make positive created water.
-            water         = 0.0;
+            setWater(0.0);
             recharge      = 0.0;
         }
     }
@@ -143,8 +148,7 @@ void SimpleVadoseZone::addOrRemoveWater(double& recharge, double& waterCreated)
 
 double SimpleVadoseZone::waterContentAtDepth(double depth) const
 {
-    double waterContent;                                      // (m^3/m^3) Return value.
-    double saturationDepth = saturationDepthFromWater(water); // (m) The current saturation depth.
+    double waterContent; // (m^3/m^3) Return value.
     
     if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
     {
@@ -170,8 +174,7 @@ double SimpleVadoseZone::waterContentAtDepth(double depth) const
 
 double SimpleVadoseZone::waterAboveDepth(double depth) const
 {
-    double waterAbove;                                        // (m) Return value.
-    double saturationDepth = saturationDepthFromWater(water); // (m) The current saturation depth.
+    double waterAbove; // (m) Return value.
     
     if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
     {
@@ -43,6 +43,7 @@
 //            0        porosity
 //
 // The model actually only stores the quantity of water in the layer and derives everything else.
+// The saturation depth derived from the quantity of water is cached because the depth queries are called several times per timestep without the water changing.
 // The capillary fringe is in hydrostatic equilibrium when the saturation depth is equal to the depth of the water table minus psiB.
 // The timestep simulation moves the quantity of water towards equilibrium putting water in to or taking water from recharge.
 // The timestep simulation also performs trivial infiltration moving water from the surface directly to recharge without simulating an infiltration front.
@@ -58,7 +59,8 @@ public:
     // waterTableDepth - (m) If this value is not NAN and is greater than or equal to zero, the water parameter is ignored, and the water member variable is initialized to be in
     //                   hydrostatic equilibrium with this water table.  Otherwise, this parameter is ignored and the water member variable is initialized to the water parameter.
     inline SimpleVadoseZone(double thickness = 1.0, double conductivity = 1.0, double porosity = 1.0, double psiB = 0.0, double water = 0.0, double waterTableDepth = NAN) :
-        thickness(thickness), conductivity(conductivity), porosity(porosity), psiB(psiB), water((0.0 <= waterTableDepth) ? waterFromSaturationDepth(std::max(waterTableDepth - psiB, 0.0)) : water)
+        thickness(thickness), conductivity(conductivity), porosity(porosity), psiB(psiB), water((0.0 <= waterTableDepth) ? waterFromSaturationDepth(std::max(waterTableDepth - psiB, 0.0)) : water),
+        saturationDepth(saturationDepthFromWater(this->water))
     {
         if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
         {
@@ -82,6 +84,11 @@ public:
         p | porosity;
         p | psiB;
         p | water;
+        
+        if (p.isUnpacking())
+        {
+            saturationDepth = saturationDepthFromWater(water);
+        }
     }
 #endif // __CHARMC__
     
@@ -196,6 +203,17 @@ private:
     // waterQuantity - (m) The qunatity of water in the layer.
     double saturationDepthFromWater(double waterQuantity) const;
     
+    // Set water and update saturationDepth to match.  All changes to water after construction must go through this method.
+    //
+    // Parameters:
+    //
+    // newWater - (m) The new quantity of water in the layer.
+    inline void setWater(double newWater)
+    {
+        water           = newWater;
+        saturationDepth = saturationDepthFromWater(water);
+    }
+    
     // Immutable attributes of the layer.
     double thickness;    // (m) The thickness of the modeled layer.
     double conductivity; // (m/s) The hydraulic conductivity of the matrix.
@@ -203,7 +221,8 @@ private:
     double psiB;         // (m) The bubbling pressure of the matrix.
     
     // Mutable state of the layer.
-    double water; // (m) The quantity of water in the layer.
+    double water;           // (m) The quantity of water in the layer.
+    double saturationDepth; // (m) Derived from water.  Not packed and not part of VADOSE_ZONE_STATE_BLOB_SIZE.  Cached value of saturationDepthFromWater(water).
 };
 
 #endif // __SIMPLE_VADOSE_ZONE_H__
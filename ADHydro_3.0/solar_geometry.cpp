@@ -0,0 +1,95 @@
+#include "solar_geometry.h"
+
+bool SolarGeometry::calculate(double julianDate, double longitude, double sinLatitude, double cosLatitude, int& yearLen, float& julian, float& cosZ)
+{
+    bool   error              = false;                                  // Error flag.
+    double localSolarDateTime = julianDate + (longitude / (2.0 * M_PI)); // (days) Julian date converted from UTC to local solar time.
+    long   noonJulianDay;                                               // (days) Julian day number of noon on the local calendar day.
+    long   year;                                                        // For filling the cache.
+    long   month;                                                       // For passing to julianToGregorian, unused.
+    long   day;                                                         // For passing to julianToGregorian, unused.
+    long   hour;                                                        // For passing to julianToGregorian, unused.
+    long   minute;                                                      // For passing to julianToGregorian, unused.
+    double second;                                                      // For passing to julianToGregorian, unused.
+    int    ii;                                                          // Loop counter and index into januaryFirstNoon of the local year.
+    double hourAngle;                                                   // (radians) How far the sun is east or west of zenith.  Positive means west.  Negative means east.
+    double declinationOfSun;                                            // (radians) How far the sun is above the horizon.
+    
+    if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
+    {
+        if (!(-M_PI * 2.0 <= longitude && M_PI * 2.0 >= longitude))
+        {
+            CkError("ERROR in SolarGeometry::calculate: longitude must be greater than or equal to negative two PI and less than or equal to two PI.\n");
+            error = true;
+        }
+        
+        if (!(-1.0 <= sinLatitude && 1.0 >= sinLatitude && 0.0 <= cosLatitude && 1.0 >= cosLatitude))
+        {
+            CkError("ERROR in SolarGeometry::calculate: sinLatitude and cosLatitude must be the sine and cosine of a latitude.\n");
+            error = true;
+        }
+    }
+    
+    if (!error)
+    {
+        // Fill the cache if this is a new UTC time.
+        if (julianDate != cachedJulianDate)
+        {
+            julianToGregorian(julianDate, &year, &month, &day, &hour, &minute, &second);
+            
+            for (ii = 0; ii < 4; ++ii)
+            {
+                januaryFirstNoon[ii] = (long)gregorianToJulian(year - 1 + ii, 1, 1, 12, 0, 0.0);
+            }
+            
+            cachedJulianDate = julianDate;
+        }
+        
+        // Find the Julian day number of noon on the local calendar day the same way julianToGregorian does.
+        noonJulianDay = (long)localSolarDateTime;
+        
+        if (localSolarDateTime - noonJulianDay >= 0.5)
+        {
+            ++noonJulianDay;
+        }
+        
+        // Find the local year.  Longitude shifts local solar time by at most a day so it is the year of the UTC time or the year before or after it.
+        for (ii = 0; ii < 2 && noonJulianDay >= januaryFirstNoon[ii + 1]; ++ii)
+        {
+        }
+        
+        if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
+        {
+            CkAssert(januaryFirstNoon[ii] <= noonJulianDay && noonJulianDay < januaryFirstNoon[ii + 1]);
+        }
+        
+        yearLen = januaryFirstNoon[ii + 1] - januaryFirstNoon[ii];
+        
+        // Calculate the ordinal day of the year by subtracting the Julian date of Jan 1 beginning midnight, which is half a day before noon.
+        julian = localSolarDateTime - (januaryFirstNoon[ii] - 0.5);
+        
+        if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
+        {
+            CkAssert(0.0f <= julian && julian < yearLen);
+        }
+        
+        // Calculate cosZ.
+        // FIXME handle slope, aspect, and long distance shading effects on solar radiation by modifying how cosZ is calculated.
+        hourAngle        = (localSolarDateTime - noonJulianDay) * 2.0 * M_PI;
+        declinationOfSun = -23.44 * (M_PI / 180.0) * cos(2.0 * M_PI * (julian + 10.0) / yearLen);
+        cosZ             = sinLatitude * sin(declinationOfSun) + cosLatitude * cos(declinationOfSun) * cos(hourAngle);
+        
+        if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
+        {
+            CkAssert(-1.0f <= cosZ && 1.0f >= cosZ);
+        }
+        
+        // If the sun is below the horizon it doesn't matter how far below.  Set cosZ to zero.
+        if (0.0f > cosZ)
+        {
+            cosZ = 0.0f;
+        }
+    }
+    
+    return error;
+}
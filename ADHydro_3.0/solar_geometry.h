@@ -0,0 +1,46 @@
+#ifndef __SOLAR_GEOMETRY_H__
+#define __SOLAR_GEOMETRY_H__
+
+#include "all.h"
+
+// A SolarGeometry calculates the inputs to Noah-MP that depend on the position of the sun: the length of the year, the ordinal day of the year, and the cosine of the solar zenith angle.
+// These depend on the local solar time of an element, which is the UTC time shifted by the element's longitude.  Finding the local calendar date with julianToGregorian for every element is
+// expensive, but the longitude shift is never more than a day so the local date of every element is in the same year as the UTC time or the year before or after it.  A SolarGeometry
+// caches the start of those years for the most recent UTC time it was asked about so that the elements of a Region that are all at the same UTC time only need simple arithmetic and trigonometry.
+// The results are identical to calling julianToGregorian and gregorianToJulian for each element.
+class SolarGeometry
+{
+public:
+    
+    // Constructor.  The cache is initially empty.
+    inline SolarGeometry() : cachedJulianDate(NAN)
+    {
+        // Initialize cache variables.
+        for (int ii = 0; ii < 4; ++ii)
+        {
+            januaryFirstNoon[ii] = 0;
+        }
+    }
+    
+    // Calculate solar geometry for one location.
+    //
+    // Returns: true if there is an error, false otherwise.
+    //
+    // Parameters:
+    //
+    // julianDate  - (days) UTC Julian date.  The cache is refilled if this is different from the last call.
+    // longitude   - (radians) Longitude of the location.
+    // sinLatitude - Sine   of the latitude of the location.
+    // cosLatitude - Cosine of the latitude of the location.
+    // yearLen     - (days) Scalar passed by reference will be filled in with the number of days in the local year, 365 or 366.
+    // julian      - (days) Scalar passed by reference will be filled in with the ordinal day of the local year including fractional day.
+    // cosZ        - Scalar passed by reference will be filled in with the cosine of the solar zenith angle, 0.0 to 1.0.  Zero if the sun is below the horizon.
+    bool calculate(double julianDate, double longitude, double sinLatitude, double cosLatitude, int& yearLen, float& julian, float& cosZ);
+    
+private:
+    
+    double cachedJulianDate;    // (days) The UTC Julian date the cache was filled in for, or NAN if the cache is empty.
+    long   januaryFirstNoon[4]; // (days) Julian day number of noon on January first of the year before the year of cachedJulianDate, that year, and the next two years.
+};
+
+#endif // __SOLAR_GEOMETRY_H__
@@ -245,13 +245,11 @@ bool surfacewaterChannelBoundaryFlowRate(double* flowRate, double* dtNew, Bounda
   return error;
 }
 
-bool surfacewaterMeshMeshFlowRate(double* flowRate, double* dtNew, double edgeLength, double elementX, double elementY, double elementZSurface,
-                                  double elementArea, double elementManningsN, double elementSurfacewaterDepth, double neighborX, double neighborY,
-                                  double neighborZSurface, double neighborArea, double neighborManningsN, double neighborSurfacewaterDepth)
+bool surfacewaterMeshMeshFlowRate(double* flowRate, double* dtNew, double edgeLength, double distance, double elementZSurface, double elementArea,
+                                  double elementManningsN, double elementSurfacewaterDepth, double neighborZSurface, double neighborArea,
+                                  double neighborManningsN, double neighborSurfacewaterDepth)
 {
   bool   error                    = false;                                                           // Error flag.
-  double distance                 = sqrt((elementX - neighborX) * (elementX - neighborX) +           // Distance between element and neighbor centers in
-                                         (elementY - neighborY) * (elementY - neighborY));           // meters.
   double averageArea              = 0.5 * (elementArea + neighborArea);                              // Area to use in flow calculation in square meters.
   double averageManningsN         = 0.5 * (elementManningsN + neighborManningsN);                    // Manning's n to use in flow calculation.
   double averageDepth             = 0.5 * (elementSurfacewaterDepth + neighborSurfacewaterDepth);    // Depth to use in flow calculation in meters.
@@ -336,10 +334,10 @@ bool surfacewaterMeshMeshFlowRate(double* flowRate, double* dtNew, double edgeLe
       ADHYDRO_ASSERT(0.0 < averageDepth && 0.0 != headSlope);
 #endif // (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
       
-      *flowRate = (pow(averageDepth, 5.0 / 3.0) / (averageManningsN * sqrt(fabs(headSlope)))) * headSlope * edgeLength;
+      *flowRate = (powFiveThirds(averageDepth) / (averageManningsN * sqrt(fabs(headSlope)))) * headSlope * edgeLength;
 
       // Suggest new timestep.
-      dtTemp = COURANT_DIFFUSIVE * sqrt(2.0 * averageArea) / (pow(averageDepth, 2.0 / 3.0) * sqrt(fabs(headSlope)) / averageManningsN + sqrt(GRAVITY * averageDepth));
+      dtTemp = COURANT_DIFFUSIVE * sqrt(2.0 * averageArea) / (powTwoThirds(averageDepth) * sqrt(fabs(headSlope)) / averageManningsN + sqrt(GRAVITY * averageDepth));
 
       if (*dtNew > dtTemp)
         {
@@ -624,7 +622,7 @@ void surfacewaterStreamStreamFlowRate(double* flowRate, double* dtNew, double el
       
       averageRadius     = 0.5 * (elementRadius + neighborRadius);
       velocityDirection = (0.0 <= headSlope) ? 1.0 : -1.0;
-      velocityMagnitude = pow(averageRadius, 2.0 / 3.0) * sqrt(fabs(headSlope)) / averageManningsN;
+      velocityMagnitude = powTwoThirds(averageRadius) * sqrt(fabs(headSlope)) / averageManningsN;
       criticalVelocity  = sqrt(GRAVITY * averageDepth);
       
 #if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_SIMPLE)
@@ -884,9 +882,11 @@ bool surfacewaterChannelChannelFlowRate(double* flowRate, double* dtNew, Channel
                                         double elementLength, double elementBaseWidth, double elementSideSlope, double elementManningsN,
                                         double elementSurfacewaterDepth, ChannelTypeEnum neighborChannelType, double neighborZBank, double neighborZBed,
                                         double neighborLength, double neighborBaseWidth, double neighborSideSlope, double neighborManningsN,
-                                        double neighborSurfacewaterDepth)
+                                        double neighborSurfacewaterDepth, double implicitDt)
 {
-  bool error = false; // Error flag.
+  bool   error = false; // Error flag.
+  double dtTemp;        // Temporary variable for suggesting new timestep in seconds.
+  double sendingVolume; // Volume of water in the sending stream element in cubic meters.
   
 #if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
   if (!(NULL != flowRate))
@@ -1002,11 +1002,44 @@ bool surfacewaterChannelChannelFlowRate(double* flowRate, double* dtNew, Channel
       ADHYDRO_ERROR("ERROR in surfacewaterChannelChannelFlowRate: neighborSurfacewaterDepth must be greater than or equal to zero.\n");
       error = true;
     }
+  
+  if (!(0.0 <= implicitDt))
+    {
+      ADHYDRO_ERROR("ERROR in surfacewaterChannelChannelFlowRate: implicitDt must be greater than or equal to zero.\n");
+      error = true;
+    }
 #endif // (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
 
   if (!error)
     {
-      if (STREAM == elementChannelType && STREAM == neighborChannelType)
+      if (STREAM == elementChannelType && STREAM == neighborChannelType && 0.0 < implicitDt)
+        {
+          // The explicit timestep suggestion is not used.
+          dtTemp = *dtNew;
+          
+          surfacewaterStreamStreamFlowRate(flowRate, &dtTemp, elementZBed, elementLength, elementBaseWidth, elementSideSlope, elementManningsN,
+                                           elementSurfacewaterDepth, neighborZBed, neighborLength, neighborBaseWidth, neighborSideSlope, neighborManningsN,
+                                           neighborSurfacewaterDepth);
+          
+          // Flow requires the sending element to have more than CHANNEL_RETENTION_DEPTH of water so sendingVolume is positive.
+          if (0.0 < *flowRate)
+            {
+              sendingVolume = elementLength * elementSurfacewaterDepth * (elementBaseWidth + elementSideSlope * elementSurfacewaterDepth);
+              *flowRate    /= 1.0 + implicitDt * *flowRate / sendingVolume;
+            }
+          else if (0.0 > *flowRate)
+            {
+              sendingVolume = neighborLength * neighborSurfacewaterDepth * (neighborBaseWidth + neighborSideSlope * neighborSurfacewaterDepth);
+              *flowRate    /= 1.0 - implicitDt * *flowRate / sendingVolume;
+            }
+          
+          // Suggest new timestep.
+          if (0.0 != *flowRate && *dtNew > implicitDt)
+            {
+              *dtNew = implicitDt;
+            }
+        }
+      else if (STREAM == elementChannelType && STREAM == neighborChannelType)
         {
           surfacewaterStreamStreamFlowRate(flowRate, dtNew, elementZBed, elementLength, elementBaseWidth, elementSideSlope, elementManningsN,
                                            elementSurfacewaterDepth, neighborZBed, neighborLength, neighborBaseWidth, neighborSideSlope, neighborManningsN,
@@ -107,23 +107,23 @@ bool surfacewaterChannelBoundaryFlowRate(double* flowRate, double* dtNew, Bounda
 //                             suggested value for the next timestep duration
 //                             in seconds.  May be updated to be shorter.
 // edgeLength                - Length of common edge in meters.
-// elementX                  - X coordinate of element center in meters.
-// elementY                  - Y coordinate of element center in meters.
+// distance                  - Distance between element and neighbor centers
+//                             in meters.  This does not change during the
+//                             simulation so the caller is expected to
+//                             calculate it once and save it.
 // elementZSurface           - Surface Z coordinate of element center in
 //                             meters.
 // elementArea               - Area of element in square meters.
 // elementManningsN          - Surface roughness of element.
 // elementSurfacewaterDepth  - Surfacewater depth of element in meters.
-// neighborX                 - X coordinate of neighbor center in meters.
-// neighborY                 - Y coordinate of neighbor center in meters.
 // neighborZSurface          - Surface Z coordinate of neighbor center in
 //                             meters.
 // neighborArea              - Area of neighbor in square meters.
 // neighborManningsN         - Surface roughness of neighbor.
 // neighborSurfacewaterDepth - Surfacewater depth of neighbor in meters.
-bool surfacewaterMeshMeshFlowRate(double* flowRate, double* dtNew, double edgeLength, double elementX, double elementY, double elementZSurface,
-                                  double elementArea, double elementManningsN, double elementSurfacewaterDepth, double neighborX, double neighborY,
-                                  double neighborZSurface, double neighborArea, double neighborManningsN, double neighborSurfacewaterDepth);
+bool surfacewaterMeshMeshFlowRate(double* flowRate, double* dtNew, double edgeLength, double distance, double elementZSurface, double elementArea,
+                                  double elementManningsN, double elementSurfacewaterDepth, double neighborZSurface, double neighborArea,
+                                  double neighborManningsN, double neighborSurfacewaterDepth);
 
 // Calculate the surfacewater flow rate in cubic meters per second between a
 // mesh element and a channel element.  Positive means flow out of the mesh
@@ -195,10 +195,27 @@ bool surfacewaterMeshChannelFlowRate(double* flowRate, double* dtNew, double edg
 // neighborSideSlope         - Side slope of neighbor, unitless.
 // neighborManningsN         - Surface roughness of neighbor.
 // neighborSurfacewaterDepth - Surfacewater depth of neighbor in meters.
+// implicitDt                - If zero stream to stream flow rates are explicit
+//                             and dtNew is limited by a Courant condition.  If
+//                             positive stream to stream flow rates are
+//                             implicit for a timestep of implicitDt seconds
+//                             and dtNew is limited to implicitDt instead.  See
+//                             below.  Flow rates involving waterbodies or ice
+//                             masses are always explicit.
+//
+// The implicit stream to stream flow rate treats the sending element as a
+// linear reservoir that drains at the explicit flow rate Q and integrates it
+// with backward Euler over implicitDt, which is Muskingum routing with X equal
+// to zero.  The explicit flow rate is divided by 1 + implicitDt * Q / V where V
+// is the volume of water in the sending element.  The sending element can
+// never send more water than it has no matter how long the timestep, which
+// removes the Courant limit of small steep reaches.  Both ends of the
+// connection calculate the same flow rate so water is conserved.  Flow is
+// attenuated when timesteps are shorter than implicitDt.
 bool surfacewaterChannelChannelFlowRate(double* flowRate, double* dtNew, ChannelTypeEnum elementChannelType, double elementZBank, double elementZBed,
                                         double elementLength, double elementBaseWidth, double elementSideSlope, double elementManningsN,
                                         double elementSurfacewaterDepth, ChannelTypeEnum neighborChannelType, double neighborZBank, double neighborZBed,
                                         double neighborLength, double neighborBaseWidth, double neighborSideSlope, double neighborManningsN,
-                                        double neighborSurfacewaterDepth);
+                                        double neighborSurfacewaterDepth, double implicitDt);
 
 #endif // __SURFACEWATER_H__
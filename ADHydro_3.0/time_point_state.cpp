@@ -1,14 +1,16 @@
 #include "time_point_state.h"
 
 TimePointState::TimePointState(size_t globalNumberOfMeshElements, size_t localNumberOfMeshElements, size_t localMeshElementStart, size_t maximumNumberOfMeshNeighbors,
-                               size_t globalNumberOfChannelElements, size_t localNumberOfChannelElements, size_t localChannelElementStart, size_t maximumNumberOfChannelNeighbors) :
+                               size_t globalNumberOfChannelElements, size_t localNumberOfChannelElements, size_t localChannelElementStart, size_t maximumNumberOfChannelNeighbors, bool delta) :
                                globalNumberOfMeshElements(globalNumberOfMeshElements), localNumberOfMeshElements(localNumberOfMeshElements), localMeshElementStart(localMeshElementStart),
                                maximumNumberOfMeshNeighbors(maximumNumberOfMeshNeighbors), globalNumberOfChannelElements(globalNumberOfChannelElements), localNumberOfChannelElements(localNumberOfChannelElements),
-                               localChannelElementStart(localChannelElementStart), maximumNumberOfChannelNeighbors(maximumNumberOfChannelNeighbors), elementsReceived(0),
+                               localChannelElementStart(localChannelElementStart), maximumNumberOfChannelNeighbors(maximumNumberOfChannelNeighbors), delta(delta), elementsReceived(0),
                                #if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_INVARIANTS)
                                meshStateReceived((0 == localNumberOfMeshElements) ? (NULL) : (new bool[localNumberOfMeshElements])),
                                channelStateReceived((0 == localNumberOfChannelElements) ? (NULL) : (new bool[localNumberOfChannelElements])),
                                #endif // (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_INVARIANTS)
+                               meshElementNumber(              (!delta || 0 == localNumberOfMeshElements)                      ? (NULL) : (new                      size_t[localNumberOfMeshElements])),
+                               channelElementNumber(           (!delta || 0 == localNumberOfChannelElements)                   ? (NULL) : (new                      size_t[localNumberOfChannelElements])),
                                meshEvapoTranspirationState(    (0 == localNumberOfMeshElements)                                ? (NULL) : (new EvapoTranspirationStateBlob[localNumberOfMeshElements])),
                                meshSurfaceWater(               (0 == localNumberOfMeshElements)                                ? (NULL) : (new                      double[localNumberOfMeshElements])),
                                meshSurfaceWaterCreated(        (0 == localNumberOfMeshElements)                                ? (NULL) : (new                      double[localNumberOfMeshElements])),
@@ -112,6 +114,8 @@ TimePointState::~TimePointState()
     delete[] meshStateReceived;
     delete[] channelStateReceived;
     #endif // (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_INVARIANTS)
+    delete[] meshElementNumber;
+    delete[] channelElementNumber;
     delete[] meshEvapoTranspirationState;
     delete[] meshSurfaceWater;
     delete[] meshSurfaceWaterCreated;
@@ -157,143 +161,417 @@ TimePointState::~TimePointState()
     delete[] channelNeighborOutflowCumulative;
 }
 
-bool TimePointState::receiveMeshState(const MeshState& state)
+bool TimePointState::receiveMeshStates(const std::vector<MeshState>& states)
 {
-    bool                                       error      = false;                                       // Error flag.
-    int                                        ii;                                                       // Loop counter.
-    std::vector<NeighborState>::const_iterator it;                                                       // Loop iterator.
-    size_t                                     localIndex = state.elementNumber - localMeshElementStart; // The array index in the TimePointState for this data.
+    bool                                   error = false; // Error flag.
+    std::vector<MeshState>::const_iterator it;            // Loop iterator.
     
     if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
     {
-        if (!(localMeshElementStart <= state.elementNumber && state.elementNumber < localMeshElementStart + localNumberOfMeshElements))
+        // Because states are in increasing element number order if the first and last are in range all of them are.  An empty vector is trivially in range.
+        if (!(states.empty() || (localMeshElementStart <= states.front().elementNumber && states.back().elementNumber < localMeshElementStart + localNumberOfMeshElements)))
         {
-            CkError("ERROR in TimePointState::receiveMeshState: received state from a mesh element I do not own.\n");
+            CkError("ERROR in TimePointState::receiveMeshStates: received state from a mesh element I do not own.\n");
             error = true;
         }
         
-        if (!(state.neighbors.size() <= maximumNumberOfMeshNeighbors))
+        // The neighbor arrays are fixed size so this must be checked for every state.
+        for (it = states.begin(); !error && it != states.end(); ++it)
         {
-            CkError("ERROR in TimePointState::receiveMeshState: received state from a mesh element with more neighbors than maximumNumberOfMeshNeighbors.\n");
-            error = true;
+            if (!(it->neighbors.size() <= maximumNumberOfMeshNeighbors))
+            {
+                CkError("ERROR in TimePointState::receiveMeshStates: received state from a mesh element with more neighbors than maximumNumberOfMeshNeighbors.\n");
+                error = true;
+            }
+        }
+    }
+    
+    if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_INVARIANTS)
+    {
+        for (it = states.begin(); !error && it != states.end(); ++it)
+        {
+            if (!(it == states.begin() || (it - 1)->elementNumber < it->elementNumber))
+            {
+                CkError("ERROR in TimePointState::receiveMeshStates: states must be in strictly increasing element number order.\n");
+                error = true;
+            }
         }
     }
     
     #if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_INVARIANTS)
-    if (!error)
+    for (it = states.begin(); !error && it != states.end(); ++it)
     {
-        if (!(!meshStateReceived[localIndex]))
+        if (!(!meshStateReceived[it->elementNumber - localMeshElementStart]))
         {
-            CkError("ERROR in TimePointState::receiveMeshState: received duplicate state from a mesh element.\n");
+            CkError("ERROR in TimePointState::receiveMeshStates: received duplicate state from a mesh element.\n");
             error = true;
         }
         else
         {
-            meshStateReceived[localIndex] = true;
+            meshStateReceived[it->elementNumber - localMeshElementStart] = true;
         }
     }
     #endif // (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_INVARIANTS)
     
     if (!error)
     {
-        elementsReceived++;
-        memcpy(meshEvapoTranspirationState[localIndex], state.evapoTranspirationState, sizeof(EvapoTranspirationStateBlob));
-        meshSurfaceWater[           localIndex] = state.surfaceWater;
-        meshSurfaceWaterCreated[    localIndex] = state.surfaceWaterCreated;
-        meshGroundwaterMode[        localIndex] = state.groundwaterMode;
-        meshPerchedHead[            localIndex] = state.perchedHead;
-        memcpy(meshSoilWater[localIndex], state.soilWater, sizeof(VadoseZoneStateBlob));
-        meshSoilWaterCreated[       localIndex] = state.soilWaterCreated;
-        meshAquiferHead[            localIndex] = state.aquiferHead;
-        memcpy(meshAquiferWater[localIndex], state.aquiferWater, sizeof(VadoseZoneStateBlob));
-        meshAquiferWaterCreated[    localIndex] = state.aquiferWaterCreated;
-        meshDeepGroundwater[        localIndex] = state.deepGroundwater;
-        meshPrecipitationRate[      localIndex] = state.precipitationRate;
-        meshPrecipitationCumulative[localIndex] = state.precipitationCumulative;
-        meshEvaporationRate[        localIndex] = state.evaporationRate;
-        meshEvaporationCumulative[  localIndex] = state.evaporationCumulative;
-        meshTranspirationRate[      localIndex] = state.transpirationRate;
-        meshTranspirationCumulative[localIndex] = state.transpirationCumulative;
-        meshCanopyWater[            localIndex] = state.canopyWater;
-        meshSnowWater[              localIndex] = state.snowWater;
-        meshRootZoneWater[          localIndex] = state.rootZoneWater;
-        meshTotalGroundwater[       localIndex] = state.totalGroundwater;
+        elementsReceived += states.size();
         
-        for (it = state.neighbors.begin(), ii = 0; it != state.neighbors.end(); ++it, ++ii)
+        for (it = states.begin(); it != states.end(); ++it)
         {
-            meshNeighborLocalEndpoint[      localIndex * maximumNumberOfMeshNeighbors + ii] = it->localEndpoint;
-            meshNeighborRemoteEndpoint[     localIndex * maximumNumberOfMeshNeighbors + ii] = it->remoteEndpoint;
-            meshNeighborRemoteElementNumber[localIndex * maximumNumberOfMeshNeighbors + ii] = it->remoteElementNumber;
-            meshNeighborNominalFlowRate[    localIndex * maximumNumberOfMeshNeighbors + ii] = it->nominalFlowRate;
-            meshNeighborExpirationTime[     localIndex * maximumNumberOfMeshNeighbors + ii] = it->expirationTime;
-            meshNeighborInflowCumulative[   localIndex * maximumNumberOfMeshNeighbors + ii] = it->inflowCumulative;
-            meshNeighborOutflowCumulative[  localIndex * maximumNumberOfMeshNeighbors + ii] = it->outflowCumulative;
+            copyInMeshState(it->elementNumber - localMeshElementStart, *it);
         }
     }
     
     return error;
 }
 
-bool TimePointState::receiveChannelState(const ChannelState& state)
+bool TimePointState::receiveChannelStates(const std::vector<ChannelState>& states)
 {
-    bool                                       error      = false;                                       // Error flag.
-    int                                        ii;                                                       // Loop counter.
-    std::vector<NeighborState>::const_iterator it;                                                       // Loop iterator.
-    size_t                                     localIndex = state.elementNumber - localMeshElementStart; // The array index in the TimePointState for this data.
+    bool                                      error = false; // Error flag.
+    std::vector<ChannelState>::const_iterator it;            // Loop iterator.
     
     if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
     {
-        if (!(localChannelElementStart <= state.elementNumber && state.elementNumber < localChannelElementStart + localNumberOfChannelElements))
+        // Because states are in increasing element number order if the first and last are in range all of them are.  An empty vector is trivially in range.
+        if (!(states.empty() || (localChannelElementStart <= states.front().elementNumber && states.back().elementNumber < localChannelElementStart + localNumberOfChannelElements)))
         {
-            CkError("ERROR in TimePointState::receiveChannelState: received state from a channel element I do not own.\n");
+            CkError("ERROR in TimePointState::receiveChannelStates: received state from a channel element I do not own.\n");
             error = true;
         }
         
-        if (!(state.neighbors.size() <= maximumNumberOfChannelNeighbors))
+        // The neighbor arrays are fixed size so this must be checked for every state.
+        for (it = states.begin(); !error && it != states.end(); ++it)
         {
-            CkError("ERROR in TimePointState::receiveChannelState: received state from a channel element with more neighbors than maximumNumberOfChannelNeighbors.\n");
-            error = true;
+            if (!(it->neighbors.size() <= maximumNumberOfChannelNeighbors))
+            {
+                CkError("ERROR in TimePointState::receiveChannelStates: received state from a channel element with more neighbors than maximumNumberOfChannelNeighbors.\n");
+                error = true;
+            }
+        }
+    }
+    
+    if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_INVARIANTS)
+    {
+        for (it = states.begin(); !error && it != states.end(); ++it)
+        {
+            if (!(it == states.begin() || (it - 1)->elementNumber < it->elementNumber))
+            {
+                CkError("ERROR in TimePointState::receiveChannelStates: states must be in strictly increasing element number order.\n");
+                error = true;
+            }
         }
     }
     
     #if (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_INVARIANTS)
-    if (!error)
+    for (it = states.begin(); !error && it != states.end(); ++it)
     {
-        if (!(!channelStateReceived[localIndex]))
+        if (!(!channelStateReceived[it->elementNumber - localChannelElementStart]))
         {
-            CkError("ERROR in TimePointState::receiveChannelState: received duplicate state from a channel element.\n");
+            CkError("ERROR in TimePointState::receiveChannelStates: received duplicate state from a channel element.\n");
             error = true;
         }
         else
         {
-            channelStateReceived[localIndex] = true;
+            channelStateReceived[it->elementNumber - localChannelElementStart] = true;
         }
     }
     #endif // (DEBUG_LEVEL & DEBUG_LEVEL_INTERNAL_INVARIANTS)
     
     if (!error)
     {
-        elementsReceived++;
-        memcpy(channelEvapoTranspirationState[localIndex], state.evapoTranspirationState, sizeof(EvapoTranspirationStateBlob));
-        channelSurfaceWater[           localIndex] = state.surfaceWater;
-        channelSurfaceWaterCreated[    localIndex] = state.surfaceWaterCreated;
-        channelPrecipitationRate[      localIndex] = state.precipitationRate;
-        channelPrecipitationCumulative[localIndex] = state.precipitationCumulative;
-        channelEvaporationRate[        localIndex] = state.evaporationRate;
-        channelEvaporationCumulative[  localIndex] = state.evaporationCumulative;
-        channelSnowWater[              localIndex] = state.snowWater;
+        elementsReceived += states.size();
         
-        for (it = state.neighbors.begin(), ii = 0; it != state.neighbors.end(); ++it, ++ii)
+        for (it = states.begin(); it != states.end(); ++it)
         {
-            channelNeighborLocalEndpoint[      localIndex * maximumNumberOfChannelNeighbors + ii] = it->localEndpoint;
-            channelNeighborRemoteEndpoint[     localIndex * maximumNumberOfChannelNeighbors + ii] = it->remoteEndpoint;
-            channelNeighborRemoteElementNumber[localIndex * maximumNumberOfChannelNeighbors + ii] = it->remoteElementNumber;
-            channelNeighborNominalFlowRate[    localIndex * maximumNumberOfChannelNeighbors + ii] = it->nominalFlowRate;
-            channelNeighborExpirationTime[     localIndex * maximumNumberOfChannelNeighbors + ii] = it->expirationTime;
-            channelNeighborInflowCumulative[   localIndex * maximumNumberOfChannelNeighbors + ii] = it->inflowCumulative;
-            channelNeighborOutflowCumulative[  localIndex * maximumNumberOfChannelNeighbors + ii] = it->outflowCumulative;
+            copyInChannelState(it->elementNumber - localChannelElementStart, *it);
         }
     }
     
     return error;
 }
+
+void TimePointState::copyInMeshState(size_t localIndex, const MeshState& state)
+{
+    int                                        ii; // Loop counter.
+    std::vector<NeighborState>::const_iterator it; // Loop iterator.
+    
+    memcpy(meshEvapoTranspirationState[localIndex], state.evapoTranspirationState, sizeof(EvapoTranspirationStateBlob));
+    meshSurfaceWater[           localIndex] = state.surfaceWater;
+    meshSurfaceWaterCreated[    localIndex] = state.surfaceWaterCreated;
+    meshGroundwaterMode[        localIndex] = state.groundwaterMode;
+    meshPerchedHead[            localIndex] = state.perchedHead;
+    memcpy(meshSoilWater[localIndex], state.soilWater, sizeof(VadoseZoneStateBlob));
+    meshSoilWaterCreated[       localIndex] = state.soilWaterCreated;
+    meshAquiferHead[            localIndex] = state.aquiferHead;
+    memcpy(meshAquiferWater[localIndex], state.aquiferWater, sizeof(VadoseZoneStateBlob));
+    meshAquiferWaterCreated[    localIndex] = state.aquiferWaterCreated;
+    meshDeepGroundwater[        localIndex] = state.deepGroundwater;
+    meshPrecipitationRate[      localIndex] = state.precipitationRate;
+    meshPrecipitationCumulative[localIndex] = state.precipitationCumulative;
+    meshEvaporationRate[        localIndex] = state.evaporationRate;
+    meshEvaporationCumulative[  localIndex] = state.evaporationCumulative;
+    meshTranspirationRate[      localIndex] = state.transpirationRate;
+    meshTranspirationCumulative[localIndex] = state.transpirationCumulative;
+    meshCanopyWater[            localIndex] = state.canopyWater;
+    meshSnowWater[              localIndex] = state.snowWater;
+    meshRootZoneWater[          localIndex] = state.rootZoneWater;
+    meshTotalGroundwater[       localIndex] = state.totalGroundwater;
+    
+    for (it = state.neighbors.begin(), ii = 0; it != state.neighbors.end(); ++it, ++ii)
+    {
+        meshNeighborLocalEndpoint[      localIndex * maximumNumberOfMeshNeighbors + ii] = it->localEndpoint;
+        meshNeighborRemoteEndpoint[     localIndex * maximumNumberOfMeshNeighbors + ii] = it->remoteEndpoint;
+        meshNeighborRemoteElementNumber[localIndex * maximumNumberOfMeshNeighbors + ii] = it->remoteElementNumber;
+        meshNeighborNominalFlowRate[    localIndex * maximumNumberOfMeshNeighbors + ii] = it->nominalFlowRate;
+        meshNeighborExpirationTime[     localIndex * maximumNumberOfMeshNeighbors + ii] = it->expirationTime;
+        meshNeighborInflowCumulative[   localIndex * maximumNumberOfMeshNeighbors + ii] = it->inflowCumulative;
+        meshNeighborOutflowCumulative[  localIndex * maximumNumberOfMeshNeighbors + ii] = it->outflowCumulative;
+    }
+}
+
+void TimePointState::copyInChannelState(size_t localIndex, const ChannelState& state)
+{
+    int                                        ii; // Loop counter.
+    std::vector<NeighborState>::const_iterator it; // Loop iterator.
+    
+    memcpy(channelEvapoTranspirationState[localIndex], state.evapoTranspirationState, sizeof(EvapoTranspirationStateBlob));
+    channelSurfaceWater[           localIndex] = state.surfaceWater;
+    channelSurfaceWaterCreated[    localIndex] = state.surfaceWaterCreated;
+    channelPrecipitationRate[      localIndex] = state.precipitationRate;
+    channelPrecipitationCumulative[localIndex] = state.precipitationCumulative;
+    channelEvaporationRate[        localIndex] = state.evaporationRate;
+    channelEvaporationCumulative[  localIndex] = state.evaporationCumulative;
+    channelSnowWater[              localIndex] = state.snowWater;
+    
+    for (it = state.neighbors.begin(), ii = 0; it != state.neighbors.end(); ++it, ++ii)
+    {
+        channelNeighborLocalEndpoint[      localIndex * maximumNumberOfChannelNeighbors + ii] = it->localEndpoint;
+        channelNeighborRemoteEndpoint[     localIndex * maximumNumberOfChannelNeighbors + ii] = it->remoteEndpoint;
+        channelNeighborRemoteElementNumber[localIndex * maximumNumberOfChannelNeighbors + ii] = it->remoteElementNumber;
+        channelNeighborNominalFlowRate[    localIndex * maximumNumberOfChannelNeighbors + ii] = it->nominalFlowRate;
+        channelNeighborExpirationTime[     localIndex * maximumNumberOfChannelNeighbors + ii] = it->expirationTime;
+        channelNeighborInflowCumulative[   localIndex * maximumNumberOfChannelNeighbors + ii] = it->inflowCumulative;
+        channelNeighborOutflowCumulative[  localIndex * maximumNumberOfChannelNeighbors + ii] = it->outflowCumulative;
+    }
+}
+
+bool TimePointState::meshElementChanged(size_t localIndex, const TimePointState& other, size_t otherLocalIndex, double threshold) const
+{
+    bool   changed;    // Return value.
+    size_t ii;         // Loop counter.
+    size_t index;      // Array index of neighbor in this TimePointState.
+    size_t otherIndex; // Array index of neighbor in other.
+    
+    if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
+    {
+        if (!(localIndex < localNumberOfMeshElements && otherLocalIndex < other.localNumberOfMeshElements))
+        {
+            CkError("ERROR in TimePointState::meshElementChanged: localIndex and otherLocalIndex must be less than localNumberOfMeshElements.\n");
+            CkExit();
+        }
+        
+        if (!(maximumNumberOfMeshNeighbors == other.maximumNumberOfMeshNeighbors))
+        {
+            CkError("ERROR in TimePointState::meshElementChanged: other must have the same maximumNumberOfMeshNeighbors.\n");
+            CkExit();
+        }
+        
+        if (!(0.0 <= threshold))
+        {
+            CkError("ERROR in TimePointState::meshElementChanged: threshold must be greater than or equal to zero.\n");
+            CkExit();
+        }
+    }
+    
+    changed = (0 != memcmp(meshEvapoTranspirationState[localIndex], other.meshEvapoTranspirationState[otherLocalIndex], sizeof(EvapoTranspirationStateBlob)) ||
+               0 != memcmp(meshSoilWater[              localIndex], other.meshSoilWater[              otherLocalIndex], sizeof(VadoseZoneStateBlob)) ||
+               0 != memcmp(meshAquiferWater[           localIndex], other.meshAquiferWater[           otherLocalIndex], sizeof(VadoseZoneStateBlob)) ||
+               meshGroundwaterMode[localIndex] != other.meshGroundwaterMode[otherLocalIndex] ||
+               threshold < fabs(meshSurfaceWater[           localIndex] - other.meshSurfaceWater[           otherLocalIndex]) ||
+               threshold < fabs(meshSurfaceWaterCreated[    localIndex] - other.meshSurfaceWaterCreated[    otherLocalIndex]) ||
+               threshold < fabs(meshPerchedHead[            localIndex] - other.meshPerchedHead[            otherLocalIndex]) ||
+               threshold < fabs(meshSoilWaterCreated[       localIndex] - other.meshSoilWaterCreated[       otherLocalIndex]) ||
+               threshold < fabs(meshAquiferHead[            localIndex] - other.meshAquiferHead[            otherLocalIndex]) ||
+               threshold < fabs(meshAquiferWaterCreated[    localIndex] - other.meshAquiferWaterCreated[    otherLocalIndex]) ||
+               threshold < fabs(meshDeepGroundwater[        localIndex] - other.meshDeepGroundwater[        otherLocalIndex]) ||
+               threshold < fabs(meshPrecipitationRate[      localIndex] - other.meshPrecipitationRate[      otherLocalIndex]) ||
+               threshold < fabs(meshPrecipitationCumulative[localIndex] - other.meshPrecipitationCumulative[otherLocalIndex]) ||
+               threshold < fabs(meshEvaporationRate[        localIndex] - other.meshEvaporationRate[        otherLocalIndex]) ||
+               threshold < fabs(meshEvaporationCumulative[  localIndex] - other.meshEvaporationCumulative[  otherLocalIndex]) ||
+               threshold < fabs(meshTranspirationRate[      localIndex] - other.meshTranspirationRate[      otherLocalIndex]) ||
+               threshold < fabs(meshTranspirationCumulative[localIndex] - other.meshTranspirationCumulative[otherLocalIndex]) ||
+               threshold < fabs(meshCanopyWater[            localIndex] - other.meshCanopyWater[            otherLocalIndex]) ||
+               threshold < fabs(meshSnowWater[              localIndex] - other.meshSnowWater[              otherLocalIndex]) ||
+               threshold < fabs(meshRootZoneWater[          localIndex] - other.meshRootZoneWater[          otherLocalIndex]) ||
+               threshold < fabs(meshTotalGroundwater[       localIndex] - other.meshTotalGroundwater[       otherLocalIndex]));
+    
+    for (ii = 0; !changed && ii < maximumNumberOfMeshNeighbors; ++ii)
+    {
+        index      = localIndex      * maximumNumberOfMeshNeighbors + ii;
+        otherIndex = otherLocalIndex * maximumNumberOfMeshNeighbors + ii;
+        changed    = (meshNeighborLocalEndpoint[      index] != other.meshNeighborLocalEndpoint[      otherIndex] ||
+                      meshNeighborRemoteEndpoint[     index] != other.meshNeighborRemoteEndpoint[     otherIndex] ||
+                      meshNeighborRemoteElementNumber[index] != other.meshNeighborRemoteElementNumber[otherIndex] ||
+                      meshNeighborExpirationTime[     index] != other.meshNeighborExpirationTime[     otherIndex] ||
+                      threshold < fabs(meshNeighborNominalFlowRate[  index] - other.meshNeighborNominalFlowRate[  otherIndex]) ||
+                      threshold < fabs(meshNeighborInflowCumulative[ index] - other.meshNeighborInflowCumulative[ otherIndex]) ||
+                      threshold < fabs(meshNeighborOutflowCumulative[index] - other.meshNeighborOutflowCumulative[otherIndex]));
+    }
+    
+    return changed;
+}
+
+bool TimePointState::channelElementChanged(size_t localIndex, const TimePointState& other, size_t otherLocalIndex, double threshold) const
+{
+    bool   changed;    // Return value.
+    size_t ii;         // Loop counter.
+    size_t index;      // Array index of neighbor in this TimePointState.
+    size_t otherIndex; // Array index of neighbor in other.
+    
+    if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
+    {
+        if (!(localIndex < localNumberOfChannelElements && otherLocalIndex < other.localNumberOfChannelElements))
+        {
+            CkError("ERROR in TimePointState::channelElementChanged: localIndex and otherLocalIndex must be less than localNumberOfChannelElements.\n");
+            CkExit();
+        }
+        
+        if (!(maximumNumberOfChannelNeighbors == other.maximumNumberOfChannelNeighbors))
+        {
+            CkError("ERROR in TimePointState::channelElementChanged: other must have the same maximumNumberOfChannelNeighbors.\n");
+            CkExit();
+        }
+        
+        if (!(0.0 <= threshold))
+        {
+            CkError("ERROR in TimePointState::channelElementChanged: threshold must be greater than or equal to zero.\n");
+            CkExit();
+        }
+    }
+    
+    changed = (0 != memcmp(channelEvapoTranspirationState[localIndex], other.channelEvapoTranspirationState[otherLocalIndex], sizeof(EvapoTranspirationStateBlob)) ||
+               threshold < fabs(channelSurfaceWater[           localIndex] - other.channelSurfaceWater[           otherLocalIndex]) ||
+               threshold < fabs(channelSurfaceWaterCreated[    localIndex] - other.channelSurfaceWaterCreated[    otherLocalIndex]) ||
+               threshold < fabs(channelPrecipitationRate[      localIndex] - other.channelPrecipitationRate[      otherLocalIndex]) ||
+               threshold < fabs(channelPrecipitationCumulative[localIndex] - other.channelPrecipitationCumulative[otherLocalIndex]) ||
+               threshold < fabs(channelEvaporationRate[        localIndex] - other.channelEvaporationRate[        otherLocalIndex]) ||
+               threshold < fabs(channelEvaporationCumulative[  localIndex] - other.channelEvaporationCumulative[  otherLocalIndex]) ||
+               threshold < fabs(channelSnowWater[              localIndex] - other.channelSnowWater[              otherLocalIndex]));
+    
+    for (ii = 0; !changed && ii < maximumNumberOfChannelNeighbors; ++ii)
+    {
+        index      = localIndex      * maximumNumberOfChannelNeighbors + ii;
+        otherIndex = otherLocalIndex * maximumNumberOfChannelNeighbors + ii;
+        changed    = (channelNeighborLocalEndpoint[      index] != other.channelNeighborLocalEndpoint[      otherIndex] ||
+                      channelNeighborRemoteEndpoint[     index] != other.channelNeighborRemoteEndpoint[     otherIndex] ||
+                      channelNeighborRemoteElementNumber[index] != other.channelNeighborRemoteElementNumber[otherIndex] ||
+                      channelNeighborExpirationTime[     index] != other.channelNeighborExpirationTime[     otherIndex] ||
+                      threshold < fabs(channelNeighborNominalFlowRate[  index] - other.channelNeighborNominalFlowRate[  otherIndex]) ||
+                      threshold < fabs(channelNeighborInflowCumulative[ index] - other.channelNeighborInflowCumulative[ otherIndex]) ||
+                      threshold < fabs(channelNeighborOutflowCumulative[index] - other.channelNeighborOutflowCumulative[otherIndex]));
+    }
+    
+    return changed;
+}
+
+void TimePointState::copyMeshElement(size_t localIndex, const TimePointState& source, size_t sourceLocalIndex)
+{
+    size_t ii;          // Loop counter.
+    size_t index;       // Array index of neighbor in this TimePointState.
+    size_t sourceIndex; // Array index of neighbor in source.
+    
+    if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
+    {
+        if (!(localIndex < localNumberOfMeshElements && sourceLocalIndex < source.localNumberOfMeshElements))
+        {
+            CkError("ERROR in TimePointState::copyMeshElement: localIndex and sourceLocalIndex must be less than localNumberOfMeshElements.\n");
+            CkExit();
+        }
+        
+        if (!(maximumNumberOfMeshNeighbors == source.maximumNumberOfMeshNeighbors))
+        {
+            CkError("ERROR in TimePointState::copyMeshElement: source must have the same maximumNumberOfMeshNeighbors.\n");
+            CkExit();
+        }
+    }
+    
+    memcpy(meshEvapoTranspirationState[localIndex], source.meshEvapoTranspirationState[sourceLocalIndex], sizeof(EvapoTranspirationStateBlob));
+    meshSurfaceWater[           localIndex] = source.meshSurfaceWater[           sourceLocalIndex];
+    meshSurfaceWaterCreated[    localIndex] = source.meshSurfaceWaterCreated[    sourceLocalIndex];
+    meshGroundwaterMode[        localIndex] = source.meshGroundwaterMode[        sourceLocalIndex];
+    meshPerchedHead[            localIndex] = source.meshPerchedHead[            sourceLocalIndex];
+    memcpy(meshSoilWater[localIndex], source.meshSoilWater[sourceLocalIndex], sizeof(VadoseZoneStateBlob));
+    meshSoilWaterCreated[       localIndex] = source.meshSoilWaterCreated[       sourceLocalIndex];
+    meshAquiferHead[            localIndex] = source.meshAquiferHead[            sourceLocalIndex];
+    memcpy(meshAquiferWater[localIndex], source.meshAquiferWater[sourceLocalIndex], sizeof(VadoseZoneStateBlob));
+    meshAquiferWaterCreated[    localIndex] = source.meshAquiferWaterCreated[    sourceLocalIndex];
+    meshDeepGroundwater[        localIndex] = source.meshDeepGroundwater[        sourceLocalIndex];
+    meshPrecipitationRate[      localIndex] = source.meshPrecipitationRate[      sourceLocalIndex];
+    meshPrecipitationCumulative[localIndex] = source.meshPrecipitationCumulative[sourceLocalIndex];
+    meshEvaporationRate[        localIndex] = source.meshEvaporationRate[        sourceLocalIndex];
+    meshEvaporationCumulative[  localIndex] = source.meshEvaporationCumulative[  sourceLocalIndex];
+    meshTranspirationRate[      localIndex] = source.meshTranspirationRate[      sourceLocalIndex];
+    meshTranspirationCumulative[localIndex] = source.meshTranspirationCumulative[sourceLocalIndex];
+    meshCanopyWater[            localIndex] = source.meshCanopyWater[            sourceLocalIndex];
+    meshSnowWater[              localIndex] = source.meshSnowWater[              sourceLocalIndex];
+    meshRootZoneWater[          localIndex] = source.meshRootZoneWater[          sourceLocalIndex];
+    meshTotalGroundwater[       localIndex] = source.meshTotalGroundwater[       sourceLocalIndex];
+    
+    for (ii = 0; ii < maximumNumberOfMeshNeighbors; ++ii)
+    {
+        index       = localIndex       * maximumNumberOfMeshNeighbors + ii;
+        sourceIndex = sourceLocalIndex * maximumNumberOfMeshNeighbors + ii;
+        meshNeighborLocalEndpoint[      index] = source.meshNeighborLocalEndpoint[      sourceIndex];
+        meshNeighborRemoteEndpoint[     index] = source.meshNeighborRemoteEndpoint[     sourceIndex];
+        meshNeighborRemoteElementNumber[index] = source.meshNeighborRemoteElementNumber[sourceIndex];
+        meshNeighborNominalFlowRate[    index] = source.meshNeighborNominalFlowRate[    sourceIndex];
+        meshNeighborExpirationTime[     index] = source.meshNeighborExpirationTime[     sourceIndex];
+        meshNeighborInflowCumulative[   index] = source.meshNeighborInflowCumulative[   sourceIndex];
+        meshNeighborOutflowCumulative[  index] = source.meshNeighborOutflowCumulative[  sourceIndex];
+    }
+}
+
+void TimePointState::copyChannelElement(size_t localIndex, const TimePointState& source, size_t sourceLocalIndex)
+{
+    size_t ii;          // Loop counter.
+    size_t index;       // Array index of neighbor in this TimePointState.
+    size_t sourceIndex; // Array index of neighbor in source.
+    
+    if (DEBUG_LEVEL & DEBUG_LEVEL_PUBLIC_FUNCTIONS_SIMPLE)
+    {
+        if (!(localIndex < localNumberOfChannelElements && sourceLocalIndex < source.localNumberOfChannelElements))
+        {
+            CkError("ERROR in TimePointState::copyChannelElement: localIndex and sourceLocalIndex must be less than localNumberOfChannelElements.\n");
+            CkExit();
+        }
+        
+        if (!(maximumNumberOfChannelNeighbors == source.maximumNumberOfChannelNeighbors))
+        {
+            CkError("ERROR in TimePointState::copyChannelElement: source must have the same maximumNumberOfChannelNeighbors.\n");
+            CkExit();
+        }
+    }
+    
+    memcpy(channelEvapoTranspirationState[localIndex], source.channelEvapoTranspirationState[sourceLocalIndex], sizeof(EvapoTranspirationStateBlob));
+    channelSurfaceWater[           localIndex] = source.channelSurfaceWater[           sourceLocalIndex];
+    channelSurfaceWaterCreated[    localIndex] = source.channelSurfaceWaterCreated[    sourceLocalIndex];
+    channelPrecipitationRate[      localIndex] = source.channelPrecipitationRate[      sourceLocalIndex];
+    channelPrecipitationCumulative[localIndex] = source.channelPrecipitationCumulative[sourceLocalIndex];
+    channelEvaporationRate[        localIndex] = source.channelEvaporationRate[        sourceLocalIndex];
+    channelEvaporationCumulative[  localIndex] = source.channelEvaporationCumulative[  sourceLocalIndex];
+    channelSnowWater[              localIndex] = source.channelSnowWater[              sourceLocalIndex];
+    
+    for (ii = 0; ii < maximumNumberOfChannelNeighbors; ++ii)
+    {
+        index       = localIndex       * maximumNumberOfChannelNeighbors + ii;
+        sourceIndex = sourceLocalIndex * maximumNumberOfChannelNeighbors + ii;
+        channelNeighborLocalEndpoint[      index] = source.channelNeighborLocalEndpoint[      sourceIndex];
+        channelNeighborRemoteEndpoint[     index] = source.channelNeighborRemoteEndpoint[     sourceIndex];
+        channelNeighborRemoteElementNumber[index] = source.channelNeighborRemoteElementNumber[sourceIndex];
+        channelNeighborNominalFlowRate[    index] = source.channelNeighborNominalFlowRate[    sourceIndex];
+        channelNeighborExpirationTime[     index] = source.channelNeighborExpirationTime[     sourceIndex];
+        channelNeighborInflowCumulative[   index] = source.channelNeighborInflowCumulative[   sourceIndex];
+        channelNeighborOutflowCumulative[  index] = source.channelNeighborOutflowCumulative[  sourceIndex];
+    }
+}
@@ -11,8 +11,9 @@ public:
     
     // Constructor.  All parameters directly initialize member variables.  Allocates arrays, sets elementsReceived to zero, and sets received flags to false.
     // Initializes all neighbors to NO_NEIGHBOR so elements only have to write neighbors that they have.
+    // meshElementNumber and channelElementNumber are only allocated if delta is true.
     TimePointState(size_t globalNumberOfMeshElements, size_t localNumberOfMeshElements, size_t localMeshElementStart, size_t maximumNumberOfMeshNeighbors,
-                   size_t globalNumberOfChannelElements, size_t localNumberOfChannelElements, size_t localChannelElementStart, size_t maximumNumberOfChannelNeighbors);
+                   size_t globalNumberOfChannelElements, size_t localNumberOfChannelElements, size_t localChannelElementStart, size_t maximumNumberOfChannelNeighbors, bool delta);
     
     // Destructor.  Deletes arrays.
     ~TimePointState();
@@ -27,23 +28,89 @@ private:
     
 public:
     
-    // Put received state into the correct location in TimePointState variables.
+    // Put a run of received state into the correct locations in TimePointState variables.
+    // Regions send states in increasing element number order so the ownership check is done once for the whole run using the first and last states.
     //
     // Returns: true if there is an error, false otherwise.
     //
     // Parameters:
     //
-    // state - The received state.
-    bool receiveMeshState(const MeshState& state);
+    // states - The received states in strictly increasing element number order.
+    bool receiveMeshStates(const std::vector<MeshState>& states);
     
-    // Put received state into the correct location in TimePointState variables.
+    // Put a run of received state into the correct locations in TimePointState variables.
+    // Regions send states in increasing element number order so the ownership check is done once for the whole run using the first and last states.
     //
     // Returns: true if there is an error, false otherwise.
     //
     // Parameters:
     //
-    // state - The received state.
-    bool receiveChannelState(const ChannelState& state);
+    // states - The received states in strictly increasing element number order.
+    bool receiveChannelStates(const std::vector<ChannelState>& states);
+    
+    // Compare the state of one mesh element to the state of the same element in another TimePointState.  Used to decide which elements go in a delta checkpoint.
+    // Opaque blobs and integer variables are compared exactly.  Real valued variables are compared with a tolerance.
+    //
+    // Returns: true if any state variable differs, false otherwise.
+    //
+    // Parameters:
+    //
+    // localIndex      - The array index of the element in this TimePointState.
+    // other           - The TimePointState to compare to.
+    // otherLocalIndex - The array index of the element in other.
+    // threshold       - Real valued variables are considered different if their absolute difference is greater than this.
+    bool meshElementChanged(size_t localIndex, const TimePointState& other, size_t otherLocalIndex, double threshold) const;
+    
+    // Compare the state of one channel element to the state of the same element in another TimePointState.  Used to decide which elements go in a delta checkpoint.
+    // Opaque blobs and integer variables are compared exactly.  Real valued variables are compared with a tolerance.
+    //
+    // Returns: true if any state variable differs, false otherwise.
+    //
+    // Parameters:
+    //
+    // localIndex      - The array index of the element in this TimePointState.
+    // other           - The TimePointState to compare to.
+    // otherLocalIndex - The array index of the element in other.
+    // threshold       - Real valued variables are considered different if their absolute difference is greater than this.
+    bool channelElementChanged(size_t localIndex, const TimePointState& other, size_t otherLocalIndex, double threshold) const;
+    
+    // Copy the state of one mesh element from another TimePointState.  Does not change elementsReceived or received flags.
+    //
+    // Parameters:
+    //
+    // localIndex       - The array index to copy to in this TimePointState.
+    // source           - The TimePointState to copy from.  Must have the same maximumNumberOfMeshNeighbors.
+    // sourceLocalIndex - The array index to copy from in source.
+    void copyMeshElement(size_t localIndex, const TimePointState& source, size_t sourceLocalIndex);
+    
+    // Copy the state of one channel element from another TimePointState.  Does not change elementsReceived or received flags.
+    //
+    // Parameters:
+    //
+    // localIndex       - The array index to copy to in this TimePointState.
+    // source           - The TimePointState to copy from.  Must have the same maximumNumberOfChannelNeighbors.
+    // sourceLocalIndex - The array index to copy from in source.
+    void copyChannelElement(size_t localIndex, const TimePointState& source, size_t sourceLocalIndex);
+    
+private:
+    
+    // Copy received state into the TimePointState variables without any checks.  Callers must check ownership, neighbor count, and duplicates.
+    //
+    // Parameters:
+    //
+    // localIndex - The array index to copy to.
+    // state      - The received state.
+    void copyInMeshState(size_t localIndex, const MeshState& state);
+    
+    // Copy received state into the TimePointState variables without any checks.  Callers must check ownership, neighbor count, and duplicates.
+    //
+    // Parameters:
+    //
+    // localIndex - The array index to copy to.
+    // state      - The received state.
+    void copyInChannelState(size_t localIndex, const ChannelState& state);
+    
+public:
     
     // Dimension sizes.  These are stored with each TimePointState because mesh adaption may cause them to change over time.
     const size_t globalNumberOfMeshElements;
@@ -55,6 +122,10 @@ public:
     const size_t localChannelElementStart;
     const size_t maximumNumberOfChannelNeighbors;
     
+    // A full TimePointState contains every element in its slice.  A delta TimePointState contains only the elements that changed since the previous checkpoint.
+    // In that case the dimension sizes above count only the changed elements, and meshElementNumber and channelElementNumber say which elements they are.
+    const bool delta;
+    
     // For checking when all state is received.
     size_t elementsReceived; // Number of both mesh and channel elements received.
     
@@ -71,6 +142,10 @@ public:
     // Pointers are all allocated, except if any array dimension is zero applicable array pointers are NULL.
     // Priority 2 and 3 variables can be set to zero if data is unavailable.
     
+    // Element numbers for delta TimePointStates.  NULL for full TimePointStates.
+    size_t*                      meshElementNumber;                  // delta only, 1D array of size localNumberOfMeshElements.     Global element number of each mesh element in this TimePointState.
+    size_t*                      channelElementNumber;               // delta only, 1D array of size localNumberOfChannelElements.  Global element number of each channel element in this TimePointState.
+    
     // Mesh state.
     EvapoTranspirationStateBlob* meshEvapoTranspirationState;        // priority 1, 1D array of size localNumberOfMeshElements.
     double*                      meshSurfaceWater;                   // priority 1, 1D array of size localNumberOfMeshElements.
@@ -8,6 +8,11 @@
 // create XDMF files.  The purpose of this program is to generate the XDMF
 // files.  The XDMF files contain metadata that is redundant with the data in
 // the NetCDF files so they are created from the NetCDF files.
+//
+// ADHydro also writes the same XDMF files itself as the simulation runs unless
+// outputXDMFFiles is false in the superfile, but those only cover the instances
+// written by that run.  Use this program to regenerate XDMF files that cover
+// every instance in the NetCDF files.
 
 // FIXME this program is a little light on error checking.  It only checks if the files can be opened.
 // FIXME we could have a more flexible way to specify the locations of all eight files that will be touched.